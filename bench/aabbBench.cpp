@@ -0,0 +1,121 @@
+// Benchmark del test di sovrapposizione: Actor::checkCollision una coppia alla
+// volta contro overlapBatch (scalare e SIMD) su un array impacchettato.
+// Prima di misurare verifica che le tre strade diano le stesse Direction.
+
+#include "lulu.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    volatile std::size_t sink = 0;
+
+    /**
+     * @brief Genera count rettangoli attorno all'origine
+     *
+     * Coordinate intere su una griglia piccola: tanti contatti esatti, bordi
+     * che si toccano e centri allineati, cioè i casi in cui un ordine diverso
+     * delle operazioni cambierebbe la Direction.
+     */
+    std::vector<std::unique_ptr<lulu::Actor>> makeBoxes(lulu::Rng& rng, const int count)
+    {
+        std::vector<std::unique_ptr<lulu::Actor>> boxes;
+        for (int i = 0; i < count; ++i)
+        {
+            const lulu::Vec2<float> pos{
+                static_cast<float>(rng.below(200)) / 2.0f - 50.0f,
+                static_cast<float>(rng.below(200)) / 2.0f - 50.0f
+            };
+            const lulu::Vec2<float> size{
+                static_cast<float>(1 + rng.below(80)) / 2.0f,
+                static_cast<float>(1 + rng.below(80)) / 2.0f
+            };
+            boxes.push_back(std::make_unique<lulu::Actor>(pos, size));
+        }
+        return boxes;
+    }
+
+    template <typename F>
+    double nsPerTest(const int rounds, const std::size_t testsPerRound, F&& body)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+            body();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (static_cast<double>(rounds) * static_cast<double>(testsPerRound));
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    lulu::Rng rng(42);
+
+    std::cout << "isa: " << lulu::overlapBatchIsa() << '\n';
+
+    for (const int count : {8, 64, 1024})
+    {
+        constexpr int QUERIES = 64;
+        const auto queries = makeBoxes(rng, QUERIES);
+        const auto boxes = makeBoxes(rng, count);
+
+        lulu::AabbBatch batch;
+        for (const auto& box : boxes)
+            batch.push(box->pos(), box->size());
+
+        std::vector<lulu::Direction> scalar(count), simd(count);
+        std::vector<std::uint64_t> scalarHits((count + 63) / 64), simdHits((count + 63) / 64);
+
+        // Verifica bit per bit contro checkCollision
+        for (const auto& query : queries)
+        {
+            lulu::overlapBatchScalar(query->pos(), query->size(), batch, scalarHits.data(), scalar.data());
+            lulu::overlapBatch(query->pos(), query->size(), batch, simdHits.data(), simd.data());
+
+            for (int i = 0; i < count; ++i)
+            {
+                const lulu::Direction expected = query->checkCollision(boxes[i].get());
+                const bool hit = simdHits[i / 64] >> (i % 64) & 1;
+                if (scalar[i] != expected || simd[i] != expected || scalarHits != simdHits ||
+                    hit != (expected != lulu::D_NONE))
+                {
+                    std::cerr << "mismatch at box " << i << ": checkCollision " << int{expected}
+                              << ", scalar " << int{scalar[i]} << ", simd " << int{simd[i]} << '\n';
+                    return 1;
+                }
+            }
+        }
+
+        const std::size_t tests = static_cast<std::size_t>(QUERIES) * count;
+        const int scaledRounds = std::max(1, rounds * 64 / count);
+
+        const double pairNs = nsPerTest(scaledRounds, tests, [&]
+        {
+            for (const auto& query : queries)
+                for (const auto& box : boxes)
+                    sink = sink + query->checkCollision(box.get());
+        });
+        const double scalarNs = nsPerTest(scaledRounds, tests, [&]
+        {
+            for (const auto& query : queries)
+                sink = sink + lulu::overlapBatchScalar(query->pos(), query->size(), batch,
+                                                       scalarHits.data(), scalar.data());
+        });
+        const double simdNs = nsPerTest(scaledRounds, tests, [&]
+        {
+            for (const auto& query : queries)
+                sink = sink + lulu::overlapBatch(query->pos(), query->size(), batch, simdHits.data(), simd.data());
+        });
+
+        std::cout << "boxes: " << count
+                  << "\tcheckCollision: " << pairNs << " ns"
+                  << "\tbatch scalar: " << scalarNs << " ns"
+                  << "\tbatch simd: " << simdNs << " ns\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Benchmark della broadphase dell'Arena: tick al secondo con 100, 1k e 10k attori,
+// più il costo di un tick in cui muoiono centinaia di zol insieme, quello di
+// caricare e distruggere una stanza, con e senza la memoria dell'arena, e gli
+// stessi muri fatti di attori o di tile.
+// Va lanciato dalla root del progetto (carica assets/characters/zol/zol.json).
+
+#include "lulu.hpp"
+#include "fighters/zol.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    constexpr float CELL = 100.0f;     // Passo della griglia su cui vengono piazzati gli attori
+    constexpr float WALL_SIZE = 50.0f; // Lato dei blocchi statici
+
+    int sideFor(const int actorCount)
+    {
+        return static_cast<int>(std::ceil(std::sqrt(static_cast<double>(actorCount))));
+    }
+
+    /**
+     * @brief Popola l'arena con actorCount attori
+     *
+     * Metà degli attori sono blocchi statici, metà sono zol, alternati su
+     * una griglia regolare: l'arena cresce con il numero di attori così la
+     * densità (e quindi il numero di collisioni reali) resta costante.
+     */
+    void populate(lulu::Arena& arena, const int actorCount, const bool pooled = true)
+    {
+        const int side = sideFor(actorCount);
+
+        for (int i = 0; i < actorCount; ++i)
+        {
+            const lulu::Vec2<float> pos{
+                static_cast<float>(i % side) * CELL + 25.0f,
+                static_cast<float>(i / side) * CELL + 25.0f
+            };
+
+            const std::uint64_t seed = arena.rng().next64();
+            if (pooled)
+            {
+                if (i % 2 == 0)
+                    arena.emplace<lulu::Actor>(pos, lulu::Vec2{WALL_SIZE, WALL_SIZE});
+                else
+                    arena.emplace<lulu::Zol>(pos, seed);
+            }
+            else
+            {
+                if (i % 2 == 0)
+                    arena.spawn(std::make_unique<lulu::Actor>(pos, lulu::Vec2{WALL_SIZE, WALL_SIZE}));
+                else
+                    arena.spawn(std::make_unique<lulu::Zol>(pos, seed));
+            }
+        }
+    }
+
+    double ticksPerSecond(lulu::Arena& arena, const int ticks)
+    {
+        constexpr lulu::KeyMask noInput = 0;
+
+        // Riscaldamento: porta gli zol fuori dalla configurazione iniziale
+        for (int i = 0; i < 10; ++i)
+            arena.tick(noInput);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i)
+            arena.tick(noInput);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return ticks / elapsed.count();
+    }
+
+    /**
+     * @brief Durata (ms) di un tick in cui killCount zol vengono rimossi insieme (es: una bomba)
+     */
+    double massDeathMs(lulu::Arena& arena, const int killCount)
+    {
+        arena.tick(0);
+
+        const auto start = std::chrono::steady_clock::now();
+        int killed = 0;
+        for (lulu::Actor* zol : arena.actorsOf(lulu::AK_ENEMY))
+        {
+            if (killed++ == killCount) break;
+            arena.despawn(zol);
+        }
+        arena.tick(0);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+    /**
+     * @brief Durata media (ms) di un cambio stanza: creare, popolare e distruggere un'arena
+     *
+     * @param pooled true = attori nella memoria dell'arena (emplace), false = make_unique
+     */
+    double roomCycleMs(const int actorCount, const bool pooled, const int cycles)
+    {
+        const float extent = static_cast<float>(sideFor(actorCount)) * CELL;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < cycles; ++i)
+        {
+            lulu::Arena arena({0.0f, 0.0f}, {extent, extent});
+            populate(arena, actorCount, pooled);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / cycles;
+    }
+
+    /**
+     * @brief Tick al secondo di una stanza a labirinto: un muro ogni due celle, zol in quelle libere
+     *
+     * @param tiles true = muri come celle di una TileMap, false = un Actor per muro
+     */
+    double wallsTicksPerSecond(const int side, const bool tiles, const int ticks)
+    {
+        const float extent = static_cast<float>(side) * WALL_SIZE;
+        lulu::RoomData room;
+        room.size = {extent, extent};
+        if (tiles)
+        {
+            room.tiles.tileSize = WALL_SIZE;
+            room.tiles.columns = side;
+            room.tiles.rows = side;
+            room.tiles.tiles.push_back({lulu::TF_SOLID, std::nullopt});
+        }
+
+        std::vector<lulu::Vec2<float>> free;
+        for (int row = 0; row < side; ++row)
+        {
+            for (int column = 0; column < side; ++column)
+            {
+                const bool wall = (row + column) % 2 == 0;
+                const lulu::Vec2<float> pos = lulu::Vec2{column, row}.convert<float>() * WALL_SIZE;
+                if (tiles)
+                    room.tiles.cells.push_back(wall ? 0 : lulu::TileMap::EMPTY);
+                else if (wall)
+                    room.blocks.push_back({pos, {WALL_SIZE, WALL_SIZE}});
+                if (!wall && (row * side + column) % 8 == 1)
+                    free.push_back(pos);
+            }
+        }
+
+        lulu::Arena arena(room);
+        for (const auto& pos : free)
+            arena.emplace<lulu::Zol>(pos, arena.rng().next64());
+        return ticksPerSecond(arena, ticks);
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const int ticks = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    for (const int actorCount : {100, 1000, 10000})
+    {
+        const float extent = static_cast<float>(sideFor(actorCount)) * CELL;
+        lulu::Arena arena({0.0f, 0.0f}, {extent, extent});
+        populate(arena, actorCount);
+
+        const double tps = ticksPerSecond(arena, ticks);
+
+        std::cout << "actors: " << actorCount << "\tticks/s: " << tps << '\n';
+    }
+
+    {
+        constexpr int actorCount = 10000;
+        constexpr int killCount = 500;
+        const float extent = static_cast<float>(sideFor(actorCount)) * CELL;
+        lulu::Arena arena({0.0f, 0.0f}, {extent, extent});
+        populate(arena, actorCount);
+
+        std::cout << "mass death: " << killCount << " of " << actorCount / 2 << " zols in one tick: "
+                  << massDeathMs(arena, killCount) << " ms\n";
+    }
+
+    for (const bool pooled : {false, true})
+    {
+        constexpr int actorCount = 10000;
+        std::cout << "room cycle (" << (pooled ? "arena memory" : "make_unique") << "): " << actorCount
+                  << " actors: " << roomCycleMs(actorCount, pooled, 20) << " ms\n";
+    }
+
+    {
+        constexpr int side = 100;
+        for (const bool tiles : {false, true})
+        {
+            std::cout << "walls (" << (tiles ? "tile map" : "actors") << "): " << side * side / 2
+                      << " walls, ticks/s: " << wallsTicksPerSecond(side, tiles, ticks) << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Microbenchmark del dispatch per tick: dynamic_cast (come facevano Arena::tick e
+// Gameplay::findLink) contro i tag ActorKind e le query tipizzate dell'Arena.
+// Va lanciato dalla root del progetto (carica i JSON di link e zol).
+
+#include "lulu.hpp"
+#include "fighters/zol.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    volatile float sink = 0.0f;
+
+    /**
+     * @brief Popola l'arena con una stanza "tipica" scalata a actorCount attori
+     *
+     * Proporzioni simili alle stanze reali: soprattutto muri, qualche nemico,
+     * porte e NPC. Link viene aggiunto per ultimo come fa Gameplay.
+     */
+    void populate(lulu::Arena& arena, const int actorCount)
+    {
+        for (int i = 0; i < actorCount; ++i)
+        {
+            const lulu::Vec2<float> pos{static_cast<float>(i % 100) * 60.0f, static_cast<float>(i / 100) * 60.0f};
+            const lulu::Vec2<float> size{50.0f, 50.0f};
+
+            switch (i % 20)
+            {
+            case 0: case 1: case 2:
+                arena.emplace<lulu::Zol>(pos, arena.rng().next64());
+                break;
+            case 3:
+                arena.emplace<lulu::Door>(pos, size, pos, "", false);
+                break;
+            case 4:
+                arena.emplace<lulu::NPC>(pos, size, "", "", "npc");
+                break;
+            default:
+                arena.emplace<lulu::Actor>(pos, size);
+                break;
+            }
+        }
+
+        arena.spawn(std::make_unique<lulu::Link>(lulu::Vec2{0.0f, 0.0f}));
+    }
+
+    // Dispatch di un tick con RTTI: cast su ogni attore e ricerca lineare di Link
+    void rttiPass(const lulu::Arena& arena)
+    {
+        for (const auto& actor : arena.actors())
+        {
+            if (dynamic_cast<lulu::Movable*>(actor.get()))
+            {
+                sink = sink + actor->speed().x;
+                if (const auto* fighter = dynamic_cast<lulu::Fighter*>(actor.get()))
+                    sink = sink + fighter->hp();
+            }
+        }
+
+        for (const auto& actor : arena.actors())
+        {
+            if (const auto* link = dynamic_cast<lulu::Link*>(actor.get()))
+            {
+                sink = sink + link->hp();
+                break;
+            }
+        }
+    }
+
+    // Stesso lavoro con i tag: si visitano solo gli attori della categoria richiesta
+    void tagPass(const lulu::Arena& arena)
+    {
+        for (lulu::Actor* actor : arena.actorsOf(lulu::AK_MOVABLE))
+        {
+            sink = sink + actor->speed().x;
+            if (const auto* fighter = actor->as<lulu::Fighter>())
+                sink = sink + fighter->hp();
+        }
+
+        if (const auto* link = arena.first<lulu::Link>())
+            sink = sink + link->hp();
+    }
+
+    template <typename F>
+    double nanosPerPass(const lulu::Arena& arena, F pass, const int passes)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < passes; ++i)
+            pass(arena);
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / passes;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const int passes = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    for (const int actorCount : {100, 1000, 10000})
+    {
+        lulu::Arena arena({0.0f, 0.0f}, {6000.0f, 6000.0f});
+        populate(arena, actorCount);
+
+        const double rtti = nanosPerPass(arena, rttiPass, passes);
+        const double tags = nanosPerPass(arena, tagPass, passes);
+
+        std::cout << "actors: " << actorCount << "\tdynamic_cast: " << rtti << " ns/tick"
+                  << "\ttags: " << tags << " ns/tick" << "\tspeedup: " << rtti / tags << "x\n";
+    }
+
+    return 0;
+}
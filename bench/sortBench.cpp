@@ -0,0 +1,84 @@
+// Benchmark dell'ordinamento della lista di disegno: std::stable_sort contro
+// lulu::radixSort su chiavi a 32 bit fatte come quelle del renderer
+// (livello | profondità | texture). Prima di misurare verifica che i due
+// ordinamenti diano lo stesso risultato, valori compresi (stabilità).
+
+#include "lulu.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    volatile std::uint32_t sink = 0;
+
+    // Pochi livelli e poche texture, profondità sparse su una stanza alta 4096 px
+    std::vector<lulu::SortItem> makeItems(lulu::Rng& rng, const int count)
+    {
+        std::vector<lulu::SortItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            const std::uint32_t layer = rng.below(2);
+            const std::uint32_t depth = rng.below(4096);
+            const std::uint32_t texture = rng.below(3);
+            items.push_back({layer << 28 | depth << 8 | texture, static_cast<std::uint32_t>(i)});
+        }
+        return items;
+    }
+
+    template <typename F>
+    double nsPerItem(const int rounds, const std::size_t items, F&& body)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r)
+            body();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (static_cast<double>(rounds) * static_cast<double>(items));
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    lulu::Rng rng(42);
+
+    for (const int count : {16, 64, 256, 1000, 10000})
+    {
+        const auto input = makeItems(rng, count);
+        const auto byKey = [](const lulu::SortItem& a, const lulu::SortItem& b) { return a.key < b.key; };
+
+        std::vector<lulu::SortItem> expected = input, items = input, scratch;
+        std::ranges::stable_sort(expected, byKey);
+        lulu::radixSort(items, scratch);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if (items[i].key != expected[i].key || items[i].value != expected[i].value)
+            {
+                std::cerr << "mismatch at " << i << '\n';
+                return 1;
+            }
+        }
+
+        const int scaledRounds = std::max(1, rounds * 100 / count);
+        const double stableNs = nsPerItem(scaledRounds, input.size(), [&]
+        {
+            items = input;
+            std::ranges::stable_sort(items, byKey);
+            sink = sink + items.front().value;
+        });
+        const double radixNs = nsPerItem(scaledRounds, input.size(), [&]
+        {
+            items = input;
+            lulu::radixSort(items, scratch);
+            sink = sink + items.front().value;
+        });
+
+        std::cout << "items: " << count
+                  << "\tstable_sort: " << stableNs << " ns/item"
+                  << "\tradixSort: " << radixNs << " ns/item\n";
+    }
+
+    return 0;
+}
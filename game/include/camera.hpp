@@ -0,0 +1,21 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+
+namespace game
+{
+  /**
+   * @brief Vista della camera che segue un punto senza uscire dal mondo
+   *
+   * Un mondo più piccolo dello schermo resta centrato. Le coordinate sono
+   * arrotondate ai pixel interi, così lo sfondo non "trema" mentre la camera
+   * scorre. Usata dal gameplay a ogni frame e dal RoomLoader per sapere
+   * quali chunk dello sfondo serviranno appena Link entra in una stanza.
+   *
+   * @param focus Punto da tenere al centro (es: il centro di Link)
+   * @param screen Dimensioni della vista
+   * @param world Dimensioni del mondo
+   * @return Rettangolo visibile in coordinate del mondo
+   */
+  Rectangle followView(lulu::Vec2<float> focus, lulu::Vec2<float> screen, lulu::Vec2<float> world);
+} // namespace game
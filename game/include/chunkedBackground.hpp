@@ -0,0 +1,101 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace game
+{
+  /**
+   * @brief Sfondo grande caricato a pezzi attorno alla camera
+   *
+   * Lo sfondo è diviso in chunk (vedi lulu::BackgroundChunks). A ogni frame
+   * update() chiede i chunk che intersecano la vista allargata di MARGIN
+   * chunk per lato: un thread di lavoro decodifica i PNG e il thread
+   * principale li carica sulla GPU entro un budget di tempo. Oltre
+   * capacity() chunk residenti vengono scaricati quelli usati meno di
+   * recente, quindi la memoria video resta limitata qualunque sia la
+   * dimensione della mappa.
+   *
+   * draw() non carica mai niente: un chunk visibile non ancora arrivato
+   * resta vuoto (si vede il colore di fondo del frame) finché update() non
+   * lo carica entro il budget, al più qualche frame dopo. All'ingresso in
+   * una stanza i chunk attorno allo spawn arrivano già caricati dal
+   * RoomLoader (vedi adopt()).
+   */
+  class ChunkedBackground final
+  {
+  public:
+    // Chunk in più per lato chiesti in anticipo rispetto alla vista
+    static constexpr int MARGIN = 1;
+
+  private:
+    struct Chunk
+    {
+      std::optional<Texture2D> texture;
+      std::uint64_t lastUsed{0}; // Ultimo frame in cui era vicino alla camera
+      bool requested{false};     // In coda o in decodifica sul thread
+    };
+
+    lulu::BackgroundChunks table_; // Immutabile: letta dal thread senza lock
+    std::size_t capacity_;
+    std::vector<Chunk> chunks_;    // Uno per cella, indicizzati con table_.index()
+    std::size_t resident_{0};
+    std::uint64_t frame_{0};
+    std::vector<std::pair<std::size_t, Image>> uploads_; // Decodificati, in attesa di budget
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::vector<std::size_t> queue_;                     // Da decodificare: il più vicino in fondo
+    std::vector<std::pair<std::size_t, Image>> decoded_; // Pronti per il thread principale
+    std::jthread worker_; // Ultimo membro: parte dopo e si ferma prima del resto
+
+    void work(const std::stop_token& stop);
+    void upload(std::size_t chunk, Texture2D texture);
+    void evict();
+
+  public:
+    /**
+     * @param table Tabella dei chunk
+     * @param viewSize Dimensioni della vista (lo schermo): fissano quanti chunk restano sulla GPU
+     */
+    ChunkedBackground(lulu::BackgroundChunks table, lulu::Vec2<float> viewSize);
+    ~ChunkedBackground();
+
+    ChunkedBackground(const ChunkedBackground&) = delete;
+    ChunkedBackground& operator=(const ChunkedBackground&) = delete;
+
+    /**
+     * @brief Chiede i chunk attorno alla vista e carica quelli pronti
+     *
+     * Da chiamare una volta per frame, prima di draw().
+     *
+     * @param view Rettangolo visibile in coordinate del mondo
+     * @param budget Secondi disponibili in questo frame per il caricamento su GPU
+     */
+    void update(Rectangle view, double budget);
+
+    /**
+     * @brief Consegna un chunk già sulla GPU (es: caricato dal RoomLoader)
+     *
+     * Lo sfondo ne diventa proprietario. Se il chunk c'è già, la texture viene liberata.
+     */
+    void adopt(std::size_t chunk, Texture2D texture);
+
+    /** @brief Disegna i chunk visibili già caricati (dentro BeginMode2D) */
+    void draw(Rectangle view) const;
+
+    [[nodiscard]] const lulu::BackgroundChunks& table() const;
+
+    /** @brief Chunk attualmente sulla GPU */
+    [[nodiscard]] std::size_t resident() const;
+
+    /** @brief Massimo di chunk sulla GPU */
+    [[nodiscard]] std::size_t capacity() const;
+  };
+} // namespace game
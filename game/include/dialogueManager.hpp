@@ -10,7 +10,7 @@ namespace game
     class DialogueManager
     {
     private:
-        const lulu::NPC* currentNPC_ = nullptr;
+        lulu::ActorHandle currentNPC_{}; // Handle e non puntatore: non può riferirsi a un NPC distrutto
         std::vector<lulu::DialogueLine> lines_;
         size_t currentLineIndex_ = 0;
         bool isActive_ = false;
@@ -29,7 +29,7 @@ namespace game
         DialogueManager();
         ~DialogueManager();
 
-        void startDialogue(const lulu::NPC* npc, const std::vector<lulu::DialogueLine>& dialogueLines);
+        void startDialogue(lulu::ActorHandle npc, const std::vector<lulu::DialogueLine>& dialogueLines);
         void update(float deltaTime);
         void render() const;
         void advance();
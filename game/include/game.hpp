@@ -1,6 +1,7 @@
 #pragma once
 #include "lulu.hpp"
 #include <memory>
+#include <string>
 
 namespace game
 {
@@ -19,15 +20,32 @@ namespace game
     // Dimensioni fisse della finestra di gioco (larghezza x altezza)
     const lulu::Vec2<int> SCREEN_SIZE{800, 550};
 
+    // Tempo massimo recuperato in un frame: dopo uno stallo (es: finestra trascinata)
+    // la simulazione non prova a recuperare centinaia di tick tutti insieme
+    static constexpr double MAX_FRAME_TIME = 0.25;
+
+    // Durata di un tick in secondi
+    const double tickDelta_;
+
+    // File in cui registrare la sessione (vuoto = nessuna registrazione)
+    const std::string recordPath_;
+
     // Puntatore alla scena attualmente attiva
     // Usa unique_ptr per gestione automatica della memoria
     std::unique_ptr<GameScene> scene_;
 
   public:
+    // Tick al secondo della simulazione: tutte le durate di gioco sono contate in tick
+    static constexpr int DEFAULT_TICK_RATE = 30;
+
     /**
      * @brief Costruttore: inizializza la finestra, audio e la scena iniziale (Menu)
+     *
+     * @param tickRate Tick al secondo della simulazione (indipendente dal refresh del monitor)
+     * @param recordPath Se non vuoto, il gameplay registra gli input in questo file
+     *                   (vedi lulu::InputLog, rigiocabile con lulu_headless --replay)
      */
-    Game();
+    explicit Game(int tickRate = DEFAULT_TICK_RATE, std::string recordPath = "");
 
     /**
      * @brief Distruttore: chiude finestra e sistema audio
@@ -38,10 +56,19 @@ namespace game
      * @brief Avvia il game loop principale
      *
      * Continua fino a quando l'utente non chiude la finestra.
-     * In ogni frame chiama tick() e render() della scena corrente.
+     * Loop a timestep fisso: il tempo reale si accumula e la scena avanza
+     * di tanti tick() quanti ne servono per raggiungerlo; poi render()
+     * disegna una volta, alla velocità consentita dal vsync, interpolando
+     * con la frazione di tick rimasta nell'accumulatore.
      */
     void run() const;
 
+    /** @brief Restituisce la durata di un tick in secondi */
+    [[nodiscard]] float tickDelta() const;
+
+    /** @brief Restituisce il file in cui registrare la sessione (vuoto = nessuno) */
+    [[nodiscard]] const std::string& recordPath() const;
+
     /**
      * @brief Cambia la scena attualmente attiva
      *
@@ -31,32 +31,39 @@ namespace game
         // Lista dei tasti che questa scena deve controllare
         std::vector<lulu::Key> inputs_;
 
+        // Tasti premuti dall'ultimo tick (raccolti frame per frame da pollPresses)
+        std::vector<int> presses_;
+
         // Riferimento al Game principale (per cambio scene)
         Game* game_;
 
         /**
          * @brief Restituisce solo i tasti attualmente premuti dalla lista inputs_
-         * @return Vector con i tasti premuti in questo frame
+         * @return Maschera dei tasti premuti in questo frame (nessuna allocazione)
          */
-        [[nodiscard]] std::vector<lulu::Key> activeInputs() const;
+        [[nodiscard]] lulu::KeyMask activeInputs() const;
 
         /**
-         * @brief Carica lo sfondo da file JSON
-         * @param configPath Percorso del file di configurazione JSON
+         * @brief Controlla se un tasto è stato premuto dall'ultimo tick
+         *
+         * Da usare al posto di IsKeyPressed dentro tick(): con il timestep
+         * fisso un tick può cadere in un frame diverso da quello della pressione.
+         *
+         * @param key Codice del tasto (KEY_SPACE, KEY_ESCAPE, ...)
          */
-        void setBackground(const std::string& configPath);
+        [[nodiscard]] bool wasPressed(int key) const;
 
         /**
-         * @brief Carica la musica da file JSON
-         * @param configPath Percorso del file di configurazione JSON
+         * @brief Sostituisce lo sfondo con una texture già caricata (ne prende possesso)
+         * @param texture Nuovo sfondo
          */
-        void setMusic(const std::string& configPath);
+        void setBackground(Texture2D texture);
 
         /**
-         * @brief Carica la lista degli input da file JSON
-         * @param configPath Percorso del file di configurazione JSON
+         * @brief Sostituisce la musica e la avvia
+         * @param music Percorso del file musicale
          */
-        void setInputs(const std::string& configPath);
+        void playMusic(const std::string& music);
 
     public:
         /**
@@ -71,12 +78,15 @@ namespace game
                   const std::vector<lulu::Key>& inputs);
 
         /**
-         * @brief Costruttore che carica tutto da file JSON
+         * @brief Costruttore da configurazione già letta (es: RoomData::scene)
+         *
+         * Il file di stanza va letto dal chiamante, una volta sola, e
+         * condiviso con l'Arena.
          *
          * @param game Puntatore al Game principale
-         * @param configPath Percorso del file di configurazione JSON
+         * @param config Sfondo (vuoto = nessuno), musica e tasti della scena
          */
-        GameScene(Game* game, const std::string& configPath);
+        GameScene(Game* game, const lulu::SceneConfig& config);
 
         /**
          * @brief Distruttore virtuale: libera texture e musica
@@ -86,7 +96,8 @@ namespace game
         /**
          * @brief Aggiorna la logica della scena (da implementare nelle sottoclassi)
          *
-         * Chiamata una volta per frame dal game loop.
+         * Chiamata dal game loop a frequenza fissa (vedi Game::tickDelta),
+         * zero, una o più volte per frame.
          * Qui va inserita tutta la logica di gioco specifica della scena.
          */
         virtual void tick() = 0;
@@ -94,9 +105,18 @@ namespace game
         /**
          * @brief Renderizza la scena sullo schermo (da implementare nelle sottoclassi)
          *
-         * Chiamata una volta per frame dal game loop, dopo tick().
+         * Chiamata una volta per frame dal game loop, dopo i tick del frame.
          * Qui va inserito tutto il codice di rendering specifico della scena.
+         *
+         * @param alpha Frazione del prossimo tick già trascorsa, in [0, 1): serve a
+         *              interpolare le posizioni tra il tick precedente e quello corrente
          */
-        virtual void render() = 0;
+        virtual void render(float alpha) = 0;
+
+        /** @brief Raccoglie i tasti premuti in questo frame (chiamata ogni frame) */
+        void pollPresses();
+
+        /** @brief Svuota i tasti raccolti (chiamata dopo ogni tick) */
+        void clearPresses();
     };
 } // namespace game
@@ -1,17 +1,39 @@
 #pragma once
+#include "chunkedBackground.hpp"
 #include "dialogueManager.hpp"
 #include <nlohmann/json.hpp>
 #include <raylib.h>
 #include "game.hpp"
 #include "gameScene.hpp"
+#include "renderList.hpp"
+#include "roomLoader.hpp"
+#include "spriteCache.hpp"
+#include "staticLayer.hpp"
 
 namespace game
 {
     class Gameplay final : public GameScene
     {
-        lulu::Arena arena_;
-        std::unordered_map<std::string, Texture2D> textureCache_;
+        // Posizione di Link all'ingresso nella prima stanza
+        static constexpr lulu::Vec2<float> LINK_SPAWN{375, 400};
+
+        // Secondi per frame concessi al caricamento su GPU delle stanze precaricate
+        static constexpr double PRELOAD_BUDGET = 0.002;
+
+        // Secondi per frame concessi al caricamento su GPU dei chunk dello sfondo
+        static constexpr double CHUNK_BUDGET = 0.002;
+
+        std::unique_ptr<lulu::Arena> arena_;
+        std::optional<lulu::InputLog> log_; // Registrazione della sessione (se richiesta)
+        SpriteCache sprites_; // Atlante e texture delle sprite, indicizzati per SpriteId
+        RenderList renderList_; // Sprite visibili del frame, ordinate per livello/profondità/texture
+        Camera2D camera_{};     // Segue Link dentro i limiti del mondo
+        std::unique_ptr<ChunkedBackground> chunks_; // Sfondo grande in streaming (al posto di background_)
+        std::unique_ptr<StaticLayer> static_; // Sfondo, tile e attori statici composti una volta
+        Texture2D tileset_{};     // Tileset dell'ultima stanza con tile, riusato finché non cambia
+        std::string tilesetPath_;
         DialogueManager dialogueManager_;
+        RoomLoader loader_; // Stanze dietro le porte, preparate in background
 
         // Texture per i cuori (caricate una volta sola)
         Texture2D heartFull_{};
@@ -25,9 +47,6 @@ namespace game
             bool changeMusic;
         };
 
-        // Gestione texture
-        Texture2D getTexture(const std::string& path);
-
         // Ricerca attori
         lulu::Link* findLink() const;
 
@@ -37,6 +56,17 @@ namespace game
 
         // Cambio stanza
         void changeRoom(lulu::Link* link, const DoorInfo& doorInfo);
+        void preloadDoors();
+
+        // Sfondo e camera
+        void loadBackground(const std::string& path);
+        void useBackground(Texture2D texture, std::optional<lulu::BackgroundChunks> chunks,
+                           std::vector<RoomLoader::ChunkTexture> chunkTextures = {});
+        lulu::Vec2<float> worldSize() const;
+        Rectangle updateCamera(float alpha);
+        void buildStaticLayer();
+        void paintStatic(Rectangle region);
+        bool bakesProps() const;
 
         // Gestione dialoghi
         void startDialogue(const lulu::NPC* npc);
@@ -46,14 +76,17 @@ namespace game
         void handleGameplayInput();
 
         // Rendering
-        void renderActors();
+        void renderActors(float alpha, Rectangle view);
         void renderHearts(float currentHp) const;
 
+        // La stanza viene letta una volta sola e condivisa tra scena e arena
+        Gameplay(Game* game, const std::string& configPath, const lulu::RoomData& room);
+
     public:
         explicit Gameplay(Game* game, const std::string& configPath = "assets/dungeon/rooms/hall.json");
         ~Gameplay() override;
 
         void tick() override;
-        void render() override;
+        void render(float alpha) override;
     };
 }
\ No newline at end of file
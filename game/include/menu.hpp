@@ -49,7 +49,9 @@ namespace game
      *
      * - Disegna lo sfondo
      * - Disegna il testo "Press SPACE to start" con trasparenza variabile
+     *
+     * @param alpha Ignorato: il menu non ha niente da interpolare
      */
-    void render() override;
+    void render(float alpha) override;
   };
 } // namespace game
@@ -0,0 +1,73 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+#include "spriteCache.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+  /**
+   * @brief Livelli di disegno, dal più basso al più alto
+   *
+   * Dentro un livello le sprite sono ordinate per profondità (il bordo
+   * inferiore: chi sta più in basso sullo schermo è più vicino e copre gli
+   * altri), poi per texture.
+   */
+  enum RenderLayer : std::uint8_t
+  {
+    RL_GROUND,  // Oggetti statici appoggiati al pavimento
+    RL_ACTORS,  // Personaggi (Link, nemici, NPC)
+    RL_OVERLAY  // Effetti sopra tutto il resto
+  };
+
+  /**
+   * @brief Lista delle sprite da disegnare in un frame, già filtrata e ordinata
+   *
+   * Viene riempita a ogni frame: le sprite fuori dalla vista vengono
+   * scartate subito, le altre ricevono una chiave a 32 bit (livello,
+   * profondità, texture) e vengono ordinate con lulu::radixSort. Così le
+   * stanze grandi inviano solo le sprite visibili e quelle sulla stessa
+   * texture finiscono vicine, in un unico batch di raylib.
+   *
+   * I buffer vengono riusati da un frame all'altro: a regime non alloca.
+   */
+  class RenderList final
+  {
+    struct Item
+    {
+      SpriteCache::Sprite sprite;
+      Vector2 pos;
+    };
+
+    Rectangle view_{};
+    std::vector<Item> items_;
+    std::vector<lulu::SortItem> keys_;
+    std::vector<lulu::SortItem> scratch_;
+    std::size_t culled_{0};
+
+  public:
+    /**
+     * @brief Svuota la lista e fissa il rettangolo visibile (coordinate del mondo)
+     */
+    void begin(Rectangle view);
+
+    /**
+     * @brief Aggiunge una sprite, se interseca la vista
+     *
+     * @param layer Livello di disegno
+     * @param sprite Texture e rettangolo sorgente (vedi SpriteCache::get)
+     * @param pos Angolo in alto a sinistra, in coordinate del mondo
+     */
+    void add(RenderLayer layer, const SpriteCache::Sprite& sprite, Vector2 pos);
+
+    /** @brief Ordina e disegna tutte le sprite aggiunte */
+    void draw();
+
+    /** @brief Sprite aggiunte e visibili in questo frame */
+    [[nodiscard]] std::size_t size() const;
+
+    /** @brief Sprite scartate perché fuori dalla vista in questo frame */
+    [[nodiscard]] std::size_t culled() const;
+  };
+} // namespace game
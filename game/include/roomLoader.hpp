@@ -0,0 +1,134 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+#include "spriteCache.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace game
+{
+  /**
+   * @brief Carica in anticipo le stanze raggiungibili dalle porte della stanza corrente
+   *
+   * Un thread di lavoro costruisce l'Arena di ogni destinazione (parsing del
+   * JSON e spawn degli attori) e decodifica le immagini della stanza (sfondo
+   * e sprite degli attori). Di uno sfondo a chunk decodifica solo i chunk
+   * che la camera mostrerà con Link allo spawn della porta, più il margine
+   * di ChunkedBackground. Il caricamento su GPU resta al thread principale,
+   * che chiama pump() una volta per frame con un budget di tempo: quando Link
+   * attraversa la porta la stanza è già pronta e il cambio non blocca il frame.
+   *
+   * Le sprite già presenti nell'atlante non vengono decodificate: sono sulla
+   * GPU dall'avvio.
+   *
+   * Una stanza presa con take() è sempre "nuova", come se fosse stata appena
+   * caricata dal file: il precaricamento non cambia la simulazione.
+   */
+  class RoomLoader final
+  {
+  public:
+    /** @brief Chunk di uno sfondo grande (indice di BackgroundChunks::index) già sulla GPU */
+    using ChunkTexture = std::pair<std::size_t, Texture2D>;
+
+    /** @brief Stanza pronta: arena costruita e texture già sulla GPU */
+    struct Room
+    {
+      std::unique_ptr<lulu::Arena> arena;
+      Texture2D background{}; // Vuota (id 0) se lo sfondo è a chunk
+      std::string music; // Percorso della musica (caricata in streaming al cambio)
+      std::optional<lulu::BackgroundChunks> chunks; // Sfondo grande, caricato in streaming dal gameplay
+      std::vector<ChunkTexture> chunkTextures;      // Chunk attorno allo spawn, da dare a ChunkedBackground::adopt
+    };
+
+    /** @brief Stanza da precaricare e punto in cui Link vi entrerà */
+    struct Destination
+    {
+      std::string path;
+      lulu::Vec2<float> spawn;
+    };
+
+  private:
+    // Lavoro del thread: tutto ciò che non tocca il contesto OpenGL
+    struct Decoded
+    {
+      std::unique_ptr<lulu::Arena> arena;
+      Image background{}; // Vuota se lo sfondo è a chunk
+      std::string music;
+      std::optional<lulu::BackgroundChunks> chunks;
+      std::vector<std::pair<std::size_t, Image>> chunkImages; // Chunk attorno allo spawn
+      std::vector<std::pair<lulu::SpriteId, Image>> sprites;
+    };
+
+    // Stato di una destinazione. Le immagini vengono consumate da pump() una alla volta.
+    struct Entry
+    {
+      std::optional<Decoded> decoded; // Vuoto finché il thread non ha finito
+      std::optional<Texture2D> background;
+      std::vector<ChunkTexture> chunkTextures;
+      lulu::Vec2<float> spawn{};
+      bool discarded{false}; // Non più raggiungibile: scartata appena il thread finisce
+    };
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_; // Sveglia il thread: c'è una stanza in coda
+    std::condition_variable ready_;    // Sveglia take(): il thread ha finito una stanza
+    std::deque<std::string> queue_;
+    std::unordered_map<std::string, Entry> rooms_;
+    const lulu::Atlas& atlas_; // Immutabile: letto dal thread senza lock
+    lulu::Vec2<float> viewSize_; // Dimensioni della vista, per i chunk attorno allo spawn
+    std::jthread worker_; // Ultimo membro: parte dopo e si ferma prima del resto
+
+    void work(const std::stop_token& stop);
+    Decoded decode(const std::string& path, lulu::Vec2<float> spawn) const;
+    static void release(Entry& entry);
+
+  public:
+    /**
+     * @param atlas Atlante delle sprite (deve sopravvivere al loader)
+     * @param viewSize Dimensioni della vista (lo schermo)
+     */
+    RoomLoader(const lulu::Atlas& atlas, lulu::Vec2<float> viewSize);
+    ~RoomLoader();
+
+    RoomLoader(const RoomLoader&) = delete;
+    RoomLoader& operator=(const RoomLoader&) = delete;
+
+    /**
+     * @brief Chiede il precaricamento delle stanze indicate
+     *
+     * Le stanze già richieste restano; quelle precaricate che non compaiono
+     * più nella lista vengono liberate.
+     *
+     * @param destinations Stanze da precaricare (es: le destinazioni delle porte)
+     */
+    void preload(const std::vector<Destination>& destinations);
+
+    /**
+     * @brief Carica su GPU le immagini già decodificate, entro un budget di tempo
+     *
+     * Da chiamare una volta per frame dal thread principale. Le sprite finiscono
+     * nella cache delle sprite del gameplay, saltando quelle già presenti.
+     *
+     * @param sprites Cache delle sprite del gameplay
+     * @param budget Secondi disponibili in questo frame
+     */
+    void pump(SpriteCache& sprites, double budget);
+
+    /**
+     * @brief Consegna una stanza precaricata
+     *
+     * Se la stanza è ancora in decodifica aspetta il thread; le texture non
+     * ancora caricate vengono caricate subito.
+     *
+     * @return La stanza, oppure nullopt se non era stata richiesta
+     */
+    std::optional<Room> take(const std::string& path, SpriteCache& sprites);
+  };
+} // namespace game
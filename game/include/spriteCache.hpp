@@ -0,0 +1,62 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace game
+{
+  /**
+   * @brief Texture delle sprite sulla GPU, indicizzate per SpriteId
+   *
+   * Le sprite presenti nell'atlante (generato da lulu_atlas) vengono
+   * disegnate come rettangoli delle sue pagine: tutta la stanza usa la
+   * stessa texture e raylib la disegna con un'unica draw call. Le altre
+   * (atlante assente o non aggiornato) ricadono su una texture per file,
+   * caricata al primo uso.
+   *
+   * Va usata solo dal thread principale (contesto OpenGL); atlas() è
+   * immutabile e si può leggere da qualsiasi thread.
+   */
+  class SpriteCache final
+  {
+  public:
+    /** @brief Dove disegnare una sprite: texture e rettangolo sorgente */
+    struct Sprite
+    {
+      Texture2D texture{};
+      Rectangle source{};
+    };
+
+  private:
+    lulu::Atlas atlas_;
+    std::vector<Texture2D> pages_;                     // Una texture per pagina dell'atlante
+    std::vector<std::optional<Texture2D>> textures_;   // Sprite fuori dall'atlante, una per file
+
+  public:
+    /**
+     * @param atlasPath Tabella dell'atlante; se manca o non è valida si usano solo i file
+     */
+    explicit SpriteCache(const std::string& atlasPath = "assets/atlas/sprites.latlas");
+    ~SpriteCache();
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    [[nodiscard]] const lulu::Atlas& atlas() const;
+
+    /** @brief Vero se la sprite si può disegnare senza caricare nulla */
+    [[nodiscard]] bool contains(lulu::SpriteId sprite) const;
+
+    /**
+     * @brief Carica su GPU una sprite già decodificata (es: dal RoomLoader)
+     *
+     * Se la sprite è già disponibile non fa nulla; l'immagine viene sempre liberata.
+     */
+    void upload(lulu::SpriteId sprite, Image image);
+
+    /** @brief Restituisce texture e rettangolo della sprite, caricandola dal file se serve */
+    Sprite get(lulu::SpriteId sprite);
+  };
+} // namespace game
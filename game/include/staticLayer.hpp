@@ -0,0 +1,71 @@
+#pragma once
+#include <raylib.h>
+#include "lulu.hpp"
+#include <functional>
+#include <vector>
+
+namespace game
+{
+  /**
+   * @brief Contenuto immobile di una stanza, composto una volta in una texture
+   *
+   * Sfondo, tile e attori statici non cambiano da un frame all'altro: vengono
+   * disegnati una volta sola in una RenderTexture e a ogni frame la stanza
+   * costa un solo quad. Quando qualcosa cambia davvero (una porta che si
+   * apre, un muro che crolla) si invalida il suo rettangolo, e update()
+   * ridisegna solo quella parte, con lo scissor attivo.
+   *
+   * Con troppi rettangoli sporchi nello stesso frame conviene ridisegnare
+   * tutto: oltre MAX_REGIONS l'intera texture viene ricomposta.
+   */
+  class StaticLayer final
+  {
+  public:
+    /** @brief Disegna il contenuto di un rettangolo (coordinate del mondo, dentro BeginMode2D) */
+    using Painter = std::function<void(Rectangle region)>;
+
+    // Rettangoli sporchi oltre i quali si ridisegna tutta la texture
+    static constexpr std::size_t MAX_REGIONS = 16;
+
+  private:
+    RenderTexture2D target_{};
+    Rectangle bounds_{};            // Parte del mondo coperta dalla texture
+    std::vector<Rectangle> dirty_;  // Da ridisegnare, già allineati ai pixel e dentro bounds_
+
+  public:
+    /**
+     * @param bounds Parte del mondo da comporre; all'inizio è tutta da disegnare
+     */
+    explicit StaticLayer(Rectangle bounds);
+    ~StaticLayer();
+
+    StaticLayer(const StaticLayer&) = delete;
+    StaticLayer& operator=(const StaticLayer&) = delete;
+
+    /**
+     * @brief Disegna i tile di una griglia che cadono in un rettangolo (coordinate del mondo)
+     *
+     * Un quad per cella: va usato dentro un Painter, non a ogni frame.
+     */
+    static void drawTiles(const lulu::TileMap& tiles, Texture2D tileset, Rectangle region);
+
+    [[nodiscard]] Rectangle bounds() const;
+
+    /** @brief Segna un rettangolo del mondo come da ridisegnare */
+    void invalidate(Rectangle region);
+
+    /** @brief Segna tutta la texture come da ridisegnare (es: nuova stanza delle stesse dimensioni) */
+    void invalidateAll();
+
+    /**
+     * @brief Ridisegna le parti invalidate
+     *
+     * Da chiamare fuori da BeginDrawing/BeginMode2D, prima di draw(). Il
+     * painter riceve ogni rettangolo sporco ed è limitato a quello dallo scissor.
+     */
+    void update(const Painter& paint);
+
+    /** @brief Disegna la texture composta (dentro BeginMode2D) */
+    void draw() const;
+  };
+} // namespace game
@@ -1,8 +1,15 @@
 #include  "game.hpp"
+#include <string>
 using namespace game;
-int main()
+int main(const int argc, char** argv)
 {
-    const Game game;
+    // --record FILE: registra la sessione per lulu_headless --replay
+    std::string recordPath;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--record")
+            recordPath = argv[++i];
+
+    const Game game(Game::DEFAULT_TICK_RATE, recordPath);
     game.run();
     return 0;
-}
\ No newline at end of file
+}
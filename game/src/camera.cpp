@@ -0,0 +1,17 @@
+#include "camera.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game
+{
+    Rectangle followView(const lulu::Vec2<float> focus, const lulu::Vec2<float> screen, const lulu::Vec2<float> world)
+    {
+        const auto axis = [](const float center, const float view, const float limit)
+        {
+            if (limit <= view) return (limit - view) / 2.0f;
+            return std::clamp(center - view / 2.0f, 0.0f, limit - view);
+        };
+
+        return {std::round(axis(focus.x, screen.x, world.x)), std::round(axis(focus.y, screen.y, world.y)), screen.x, screen.y};
+    }
+} // namespace game
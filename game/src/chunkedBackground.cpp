@@ -0,0 +1,205 @@
+#include "chunkedBackground.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace game
+{
+    namespace
+    {
+        lulu::BackgroundChunks::Range rangeOf(const lulu::BackgroundChunks& table, const Rectangle view, const int margin)
+        {
+            return table.range({view.x, view.y}, {view.width, view.height}, margin);
+        }
+    }
+
+    ChunkedBackground::ChunkedBackground(lulu::BackgroundChunks table, const lulu::Vec2<float> viewSize)
+        : table_(std::move(table)),
+          chunks_(static_cast<std::size_t>(table_.columns()) * static_cast<std::size_t>(table_.rows())),
+          worker_([this](const std::stop_token& stop) { work(stop); })
+    {
+        // Il massimo di chunk che la vista (non allineata) più il margine può toccare
+        const auto side = static_cast<float>(table_.chunkSize);
+        const auto across = [&](const float length)
+        {
+            return static_cast<std::size_t>(std::ceil(length / side)) + 1 + 2 * MARGIN;
+        };
+        capacity_ = across(viewSize.x) * across(viewSize.y);
+    }
+
+    ChunkedBackground::~ChunkedBackground()
+    {
+        // Prima si ferma il thread, poi si liberano immagini e texture (sul thread principale)
+        worker_.request_stop();
+        wake_.notify_all();
+        worker_.join();
+
+        for (const auto& [chunk, image] : decoded_)
+            UnloadImage(image);
+        for (const auto& [chunk, image] : uploads_)
+            UnloadImage(image);
+        for (const Chunk& chunk : chunks_)
+            if (chunk.texture) UnloadTexture(*chunk.texture);
+    }
+
+    void ChunkedBackground::work(const std::stop_token& stop)
+    {
+        const auto columns = static_cast<std::size_t>(table_.columns());
+        while (true)
+        {
+            std::size_t chunk;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, stop, [this] { return !queue_.empty(); });
+                if (stop.stop_requested()) return;
+
+                chunk = queue_.back();
+                queue_.pop_back();
+            }
+
+            // Fuori dal lock: il thread principale continua a girare
+            const Image image = LoadImage(table_.path(static_cast<int>(chunk % columns),
+                                                      static_cast<int>(chunk / columns)).c_str());
+
+            std::scoped_lock lock(mutex_);
+            decoded_.emplace_back(chunk, image);
+        }
+    }
+
+    void ChunkedBackground::upload(const std::size_t chunk, const Texture2D texture)
+    {
+        chunks_[chunk].texture = texture;
+        ++resident_;
+    }
+
+    void ChunkedBackground::evict()
+    {
+        if (resident_ <= capacity_) return;
+
+        // I chunk vicini alla camera hanno lastUsed == frame_ e non vengono mai scelti
+        std::vector<std::size_t> candidates;
+        for (std::size_t i = 0; i < chunks_.size(); ++i)
+        {
+            if (chunks_[i].texture && chunks_[i].lastUsed < frame_)
+                candidates.push_back(i);
+        }
+        std::ranges::sort(candidates, {}, [this](const std::size_t i) { return chunks_[i].lastUsed; });
+
+        for (const std::size_t i : candidates)
+        {
+            if (resident_ <= capacity_) break;
+            UnloadTexture(*chunks_[i].texture);
+            chunks_[i].texture.reset();
+            --resident_;
+        }
+    }
+
+    void ChunkedBackground::update(const Rectangle view, const double budget)
+    {
+        const double start = GetTime();
+        ++frame_;
+
+        const auto wanted = rangeOf(table_, view, MARGIN);
+        for (int row = wanted.firstRow; row <= wanted.lastRow; ++row)
+            for (int column = wanted.firstColumn; column <= wanted.lastColumn; ++column)
+                chunks_[table_.index(column, row)].lastUsed = frame_;
+
+        {
+            std::scoped_lock lock(mutex_);
+
+            // La coda si rifà da capo: i chunk che la camera ha lasciato non vengono più decodificati
+            for (const std::size_t chunk : queue_)
+                chunks_[chunk].requested = false;
+            queue_.clear();
+
+            for (int row = wanted.firstRow; row <= wanted.lastRow; ++row)
+            {
+                for (int column = wanted.firstColumn; column <= wanted.lastColumn; ++column)
+                {
+                    const std::size_t chunk = table_.index(column, row);
+                    if (!chunks_[chunk].texture && !chunks_[chunk].requested)
+                    {
+                        queue_.push_back(chunk);
+                        chunks_[chunk].requested = true;
+                    }
+                }
+            }
+
+            // Il più vicino al centro della vista in fondo: il thread lo prende per primo
+            const float centerX = view.x + view.width / 2;
+            const float centerY = view.y + view.height / 2;
+            const float half = static_cast<float>(table_.chunkSize) / 2;
+            const int columns = table_.columns();
+            std::ranges::sort(queue_, std::ranges::greater{}, [&](const std::size_t chunk)
+            {
+                const auto [x, y] = table_.origin(static_cast<int>(chunk) % columns, static_cast<int>(chunk) / columns);
+                return std::abs(x + half - centerX) + std::abs(y + half - centerY);
+            });
+
+            std::ranges::move(decoded_, std::back_inserter(uploads_));
+            decoded_.clear();
+        }
+        wake_.notify_all();
+
+        // Caricamento su GPU entro il budget: almeno un chunk per frame, il resto aspetta
+        while (!uploads_.empty())
+        {
+            const auto [chunk, image] = uploads_.back();
+            uploads_.pop_back();
+
+            Chunk& entry = chunks_[chunk];
+            entry.requested = false;
+            if (!entry.texture && entry.lastUsed == frame_ && image.data)
+                upload(chunk, LoadTextureFromImage(image));
+            UnloadImage(image);
+
+            if (GetTime() - start >= budget) break;
+        }
+
+        evict();
+    }
+
+    void ChunkedBackground::adopt(const std::size_t chunk, const Texture2D texture)
+    {
+        if (texture.id == 0) return; // PNG non leggibile: update() riproverà
+
+        if (chunks_[chunk].texture)
+        {
+            UnloadTexture(texture);
+            return;
+        }
+        upload(chunk, texture);
+    }
+
+    void ChunkedBackground::draw(const Rectangle view) const
+    {
+        const auto visible = rangeOf(table_, view, 0);
+        for (int row = visible.firstRow; row <= visible.lastRow; ++row)
+        {
+            for (int column = visible.firstColumn; column <= visible.lastColumn; ++column)
+            {
+                // Non ancora arrivato: update() lo ha già chiesto al thread, per ora resta vuoto
+                const auto& texture = chunks_[table_.index(column, row)].texture;
+                if (!texture) continue;
+
+                const auto [x, y] = table_.origin(column, row);
+                DrawTextureV(*texture, {x, y}, WHITE);
+            }
+        }
+    }
+
+    const lulu::BackgroundChunks& ChunkedBackground::table() const
+    {
+        return table_;
+    }
+
+    std::size_t ChunkedBackground::resident() const
+    {
+        return resident_;
+    }
+
+    std::size_t ChunkedBackground::capacity() const
+    {
+        return capacity_;
+    }
+} // namespace game
@@ -35,7 +35,7 @@ namespace game
         }
     }
 
-    void DialogueManager::startDialogue(const lulu::NPC *npc, const std::vector<lulu::DialogueLine> &dialogueLines)
+    void DialogueManager::startDialogue(const lulu::ActorHandle npc, const std::vector<lulu::DialogueLine> &dialogueLines)
     {
         currentNPC_ = npc;
         lines_ = dialogueLines;
@@ -84,7 +84,7 @@ namespace game
 
     void DialogueManager::reset()
     {
-        currentNPC_ = nullptr;
+        currentNPC_ = {};
         lines_.clear();
         currentLineIndex_ = 0;
         isActive_ = false;
@@ -1,12 +1,15 @@
 #include "game.hpp"
 #include "menu.hpp"
+#include <algorithm>
 
 namespace game
 {
-    Game::Game()
+    Game::Game(const int tickRate, std::string recordPath)
+        : tickDelta_(1.0 / tickRate), recordPath_(std::move(recordPath))
     {
+        // Il rendering segue il refresh del monitor, la simulazione il tick rate
+        SetConfigFlags(FLAG_VSYNC_HINT);
         InitWindow(SCREEN_SIZE.x, SCREEN_SIZE.y, "The Legend of LuLù");
-        SetTargetFPS(30);
         InitAudioDevice();
 
         scene_ = std::make_unique<Menu>(this);
@@ -20,13 +23,40 @@ namespace game
 
     void Game::run() const
     {
+        double accumulator = 0.0;
+        double previousTime = GetTime();
+
         while (!WindowShouldClose())
         {
-            scene_->tick();
-            scene_->render();
+            const double currentTime = GetTime();
+            accumulator += std::min(currentTime - previousTime, MAX_FRAME_TIME);
+            previousTime = currentTime;
+
+            // Gli eventi "premuto" durano un solo frame: vanno raccolti anche nei frame senza tick
+            scene_->pollPresses();
+
+            while (accumulator >= tickDelta_)
+            {
+                // tick() può cambiare scena: si rilegge sempre scene_
+                scene_->tick();
+                scene_->clearPresses();
+                accumulator -= tickDelta_;
+            }
+
+            scene_->render(static_cast<float>(accumulator / tickDelta_));
         }
     }
 
+    float Game::tickDelta() const
+    {
+        return static_cast<float>(tickDelta_);
+    }
+
+    const std::string& Game::recordPath() const
+    {
+        return recordPath_;
+    }
+
     void Game::switchScene(std::unique_ptr<GameScene>& newScene)
     {
         scene_ = std::move(newScene);
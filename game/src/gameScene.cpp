@@ -1,23 +1,21 @@
 #include "gameScene.hpp"
-#include <fstream>
-#include <nlohmann/json.hpp>
+#include <algorithm>
 
 namespace game
 {
     GameScene::GameScene(Game* game, const std::string& background, const std::string& music,
                          const std::vector<lulu::Key>& inputs)
-        : inputs_(inputs), game_(game)
+        : GameScene(game, lulu::SceneConfig{background, music, inputs})
     {
-        background_ = LoadTexture(background.c_str());
-        music_ = LoadMusicStream(music.c_str());
-        PlayMusicStream(music_);
     }
 
-    GameScene::GameScene(Game* game, const std::string& configPath) : game_(game)
+    GameScene::GameScene(Game* game, const lulu::SceneConfig& config)
+        : inputs_(config.inputs), game_(game)
     {
-        setBackground(configPath);
-        setMusic(configPath);
-        setInputs(configPath);
+        if (!config.background.empty())
+            background_ = LoadTexture(config.background.c_str());
+        music_ = LoadMusicStream(config.music.c_str());
+        PlayMusicStream(music_);
     }
 
     GameScene::~GameScene()
@@ -26,39 +24,17 @@ namespace game
         UnloadMusicStream(music_);
     }
 
-    void GameScene::setBackground(const std::string& configPath)
+    void GameScene::setBackground(const Texture2D texture)
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
-        {
-            throw std::runtime_error("Could not open config file: " + configPath);
-        }
-
-        nlohmann::json j;
-        f >> j;
-
-        // leggi i campi
-        auto background = j.at("background").get<std::string>();
-
         if (background_.id != 0)
         {
             UnloadTexture(background_);
         }
-        background_ = LoadTexture(background.c_str());
+        background_ = texture;
     }
 
-    void GameScene::setMusic(const std::string& configPath)
+    void GameScene::playMusic(const std::string& music)
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
-        {
-            throw std::runtime_error("Could not open config file: " + configPath);
-        }
-
-        nlohmann::json j;
-        f >> j;
-
-        auto music = j.at("music").get<std::string>();
         if (music_.ctxData != nullptr)
         {
             UnloadMusicStream(music_);
@@ -67,31 +43,28 @@ namespace game
         PlayMusicStream(music_);
     }
 
-    void GameScene::setInputs(const std::string& configPath)
+    lulu::KeyMask GameScene::activeInputs() const
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
-        {
-            throw std::runtime_error("Could not open config file: " + configPath);
-        }
+        lulu::KeyMask keys = 0;
+        for (const lulu::Key key : inputs_)
+            if (IsKeyDown(key))
+                keys |= lulu::keyBit(key);
+        return keys;
+    }
 
-        nlohmann::json j;
-        f >> j;
+    bool GameScene::wasPressed(const int key) const
+    {
+        return std::ranges::find(presses_, key) != presses_.end();
+    }
 
-        inputs_.clear();
-        for (const auto& val : j.at("inputs"))
-        {
-            inputs_.push_back(static_cast<lulu::Key>(val.get<int>()));
-        }
+    void GameScene::pollPresses()
+    {
+        while (const int key = GetKeyPressed())
+            presses_.push_back(key);
     }
 
-    std::vector<lulu::Key> GameScene::activeInputs() const
+    void GameScene::clearPresses()
     {
-        std::vector<lulu::Key> keys;
-        keys.reserve(inputs_.size());
-        for (lulu::Key key : inputs_)
-            if (IsKeyDown(key))
-                keys.push_back(key);
-        return keys;
+        presses_.clear();
     }
 } // namespace game
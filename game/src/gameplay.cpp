@@ -1,4 +1,7 @@
 #include "gameplay.hpp"
+#include "camera.hpp"
+#include <algorithm>
+#include <cmath>
 #include <nlohmann/json.hpp>
 #include "game.hpp"
 #include "menu.hpp"
@@ -6,51 +9,73 @@
 
 namespace game
 {
+    namespace
+    {
+        // Gli attori statici (tranne gli NPC) stanno sotto a tutto e non si muovono
+        RenderLayer layerOf(const lulu::Actor& actor)
+        {
+            return actor.is(lulu::AK_MOVABLE) || actor.is(lulu::AK_NPC) ? RL_ACTORS : RL_GROUND;
+        }
+    }
+
     Gameplay::Gameplay(Game* game, const std::string& configPath)
-        : GameScene(game, configPath), arena_(configPath)
+        : Gameplay(game, configPath, lulu::RoomData::load(configPath))
     {
-        arena_.spawn(std::make_unique<lulu::Link>(lulu::Vec2{375, 400}.convert<float>()));
+    }
+
+    Gameplay::Gameplay(Game* game, const std::string& configPath, const lulu::RoomData& room)
+        : GameScene(game, lulu::SceneConfig{{}, room.scene.music, room.scene.inputs}), arena_(std::make_unique<lulu::Arena>(room)), loader_(sprites_.atlas(), lulu::Vec2{GetScreenWidth(), GetScreenHeight()}.convert<float>())
+    {
+        loadBackground(room.scene.background);
+        buildStaticLayer();
+        arena_->spawn(std::make_unique<lulu::Link>(LINK_SPAWN));
+
+        if (!game->recordPath().empty())
+        {
+            log_.emplace(configPath, arena_->seed(), LINK_SPAWN);
+        }
 
         // Carica le texture dei cuori una volta sola
         heartFull_ = LoadTexture("assets/ui/hearts/full_heart.png");
         heartHalf_ = LoadTexture("assets/ui/hearts/half_heart.png");
         heartEmpty_ = LoadTexture("assets/ui/hearts/empty_heart.png");
+
+        preloadDoors();
     }
 
     Gameplay::~Gameplay()
     {
-        for (const auto& texture : textureCache_ | std::views::values)
-            UnloadTexture(texture);
+        if (log_)
+        {
+            try
+            {
+                log_->save(game_->recordPath());
+            }
+            catch (const std::exception& e)
+            {
+                TraceLog(LOG_WARNING, "%s", e.what());
+            }
+        }
 
         // Scarica le texture dei cuori
         UnloadTexture(heartFull_);
         UnloadTexture(heartHalf_);
         UnloadTexture(heartEmpty_);
-    }
 
-    Texture2D Gameplay::getTexture(const std::string& path)
-    {
-        // Usa emplace per evitare lookup doppio
-        auto [it, inserted] = textureCache_.try_emplace(path, Texture2D{});
-        if (inserted)
+        static_.reset();
+        if (tileset_.id != 0)
         {
-            it->second = LoadTexture(path.c_str());
+            UnloadTexture(tileset_);
         }
-        return it->second;
     }
 
     void Gameplay::tick()
     {
-        static double lastTime = GetTime();
-        const double currentTime = GetTime();
-        const auto deltaTime = static_cast<float>(currentTime - lastTime);
-        lastTime = currentTime;
-
         UpdateMusicStream(music_);
 
         if (dialogueManager_.isActive())
         {
-            handleDialogueInput(deltaTime);
+            handleDialogueInput(game_->tickDelta());
         }
         else
         {
@@ -62,7 +87,7 @@ namespace game
     {
         dialogueManager_.update(deltaTime);
 
-        if (IsKeyPressed(KEY_SPACE))
+        if (wasPressed(KEY_SPACE))
         {
             dialogueManager_.advance();
             if (!dialogueManager_.isActive())
@@ -71,7 +96,7 @@ namespace game
             }
         }
 
-        if (IsKeyPressed(KEY_ESCAPE))
+        if (wasPressed(KEY_ESCAPE))
         {
             dialogueManager_.reset();
         }
@@ -79,7 +104,13 @@ namespace game
 
     void Gameplay::handleGameplayInput()
     {
-        arena_.tick(activeInputs());
+        const lulu::KeyMask keys = activeInputs();
+        arena_->tick(keys);
+
+        if (log_)
+        {
+            log_->record(keys, arena_->stateHash());
+        }
 
         lulu::Link* pLink = findLink();
         if (!pLink) return;
@@ -103,7 +134,7 @@ namespace game
     void Gameplay::startDialogue(const lulu::NPC* npc)
     {
         const auto dialogueLines = npc->loadDialogue();
-        dialogueManager_.startDialogue(npc, dialogueLines);
+        dialogueManager_.startDialogue(npc->handle(), dialogueLines);
     }
 
     void Gameplay::renderHearts(const float currentHp) const
@@ -155,13 +186,44 @@ namespace game
         }
     }
 
-    void Gameplay::render()
+    void Gameplay::render(const float alpha)
     {
+        loader_.pump(sprites_, PRELOAD_BUDGET);
+
+        const Rectangle view = updateCamera(alpha);
+        if (chunks_)
+        {
+            chunks_->update(view, CHUNK_BUDGET);
+        }
+
+        // Il contenuto statico si ridisegna solo dove è cambiato (di solito mai)
+        if (static_)
+        {
+            for (const auto& [pos, size] : arena_->dirtyRegions())
+            {
+                static_->invalidate({pos.x, pos.y, size.x, size.y});
+            }
+            static_->update([this](const Rectangle region) { paintStatic(region); });
+        }
+        arena_->clearDirtyRegions();
+
         BeginDrawing();
         ClearBackground(BLACK);
-        DrawTexture(background_, 0, 0, WHITE);
 
-        renderActors();
+        // Mondo: coordinate della stanza, spostate dalla camera
+        BeginMode2D(camera_);
+        if (chunks_)
+        {
+            chunks_->draw(view);
+        }
+        if (static_)
+        {
+            static_->draw();
+        }
+        renderActors(alpha, view);
+        EndMode2D();
+
+        // Interfaccia: coordinate dello schermo
 
         // Renderizza i cuori (HP di Link)
         if (const lulu::Link* pLink = findLink())
@@ -177,40 +239,41 @@ namespace game
         EndDrawing();
     }
 
-    void Gameplay::renderActors()
+    void Gameplay::renderActors(const float alpha, const Rectangle view)
     {
-        for (const auto& actor : arena_.actors())
+        renderList_.begin(view);
+
+        const bool baked = bakesProps();
+        const auto actors = arena_->actors();
+        const lulu::TransformStore& transforms = arena_->transforms(); // Parallelo ad actors
+        for (std::uint32_t i = 0; i < actors.size(); ++i)
         {
-            if (const std::string& sprite = actor->sprite(); !sprite.empty())
+            const auto& actor = actors[i];
+            if (const lulu::SpriteId sprite = actor->sprite(); sprite != lulu::NO_SPRITE)
             {
-                const Texture2D& texture = getTexture(sprite);
-                auto [x, y] = actor->pos().convert<int>();
-                DrawTexture(texture, x, y, WHITE);
+                const RenderLayer layer = layerOf(*actor);
+                if (layer == RL_GROUND && baked) continue; // Già nel livello statico
+
+                // Posizione intera come con DrawTexture: niente sprite "sfocate" tra due pixel
+                const auto [x, y] = transforms.interpolatedPos(i, alpha).convert<int>().convert<float>();
+                renderList_.add(layer, sprites_.get(sprite), {x, y});
             }
         }
+
+        // Con l'atlante le sprite dello stesso livello stanno sulla stessa texture: un solo batch
+        renderList_.draw();
     }
 
     lulu::Link* Gameplay::findLink() const
     {
-        for (const auto& actor : arena_.actors())
-        {
-            if (auto* link = dynamic_cast<lulu::Link*>(actor.get()))
-            {
-                return link;
-            }
-        }
-        return nullptr;
+        return arena_->first<lulu::Link>();
     }
 
     std::optional<Gameplay::DoorInfo> Gameplay::checkDoorCollision(const lulu::Link* link) const
     {
-        const auto& collisions = arena_.collisions();
-        const auto it = collisions.find(link);
-        if (it == collisions.end()) return std::nullopt;
-
-        for (const auto& [target, direction] : it->second)
+        for (const auto& [target, direction] : arena_->collisions(link->handle()))
         {
-            if (const auto* door = dynamic_cast<lulu::Door*>(target))
+            if (const auto* door = arena_->get<lulu::Door>(target))
             {
                 return DoorInfo{
                     door->destination(),
@@ -224,13 +287,9 @@ namespace game
 
     std::optional<const lulu::NPC*> Gameplay::checkNpcCollision(const lulu::Link* link) const
     {
-        const auto& collisions = arena_.collisions();
-        const auto it = collisions.find(link);
-        if (it == collisions.end()) return std::nullopt;
-
-        for (const auto& [target, direction] : it->second)
+        for (const auto& [target, direction] : arena_->collisions(link->handle()))
         {
-            if (const auto* npc = dynamic_cast<lulu::NPC*>(target))
+            if (const auto* npc = arena_->get<lulu::NPC>(target))
             {
                 return npc;
             }
@@ -240,18 +299,205 @@ namespace game
 
     void Gameplay::changeRoom(lulu::Link* link, const DoorInfo& doorInfo)
     {
-        auto linkPtr = arena_.kill(link);
+        auto linkPtr = arena_->kill(link);
         if (!linkPtr) return;
 
-        arena_ = lulu::Arena(doorInfo.destination);
-        setBackground(doorInfo.destination);
+        if (auto room = loader_.take(doorInfo.destination, sprites_))
+        {
+            // Precaricata: niente parsing né LoadTexture in questo frame
+            arena_ = std::move(room->arena);
+            useBackground(room->background, std::move(room->chunks), std::move(room->chunkTextures));
+
+            if (doorInfo.changeMusic)
+            {
+                playMusic(room->music);
+            }
+        }
+        else
+        {
+            // Una sola lettura del file per arena, sfondo e musica
+            const std::size_t loads = lulu::RoomData::loadCount();
+            const auto data = lulu::RoomData::load(doorInfo.destination);
+
+            // Nuova arena allocata a parte: gli attori tengono un puntatore alla loro arena
+            arena_ = std::make_unique<lulu::Arena>(data);
+            loadBackground(data.scene.background);
+
+            if (doorInfo.changeMusic)
+            {
+                playMusic(data.scene.music);
+            }
+
+            // Il contatore è globale: include eventuali letture del precaricamento in corso
+            TraceLog(LOG_DEBUG, "Room %s loaded synchronously (%zu room file reads)",
+                     doorInfo.destination.c_str(), lulu::RoomData::loadCount() - loads);
+        }
+
+        buildStaticLayer();
+
+        arena_->spawn(std::move(linkPtr), doorInfo.spawn);
+
+        preloadDoors();
+    }
+
+    void Gameplay::preloadDoors()
+    {
+        std::vector<RoomLoader::Destination> destinations;
+        arena_->forEach<lulu::Door>([&](const lulu::Door& door)
+        {
+            if (std::ranges::find(destinations, door.destination(), &RoomLoader::Destination::path) == destinations.end())
+                destinations.push_back({door.destination(), door.spawn()});
+        });
+        loader_.preload(destinations);
+    }
+
+    void Gameplay::loadBackground(const std::string& path)
+    {
+        if (auto chunks = lulu::BackgroundChunks::find(path))
+        {
+            useBackground(Texture2D{}, std::move(chunks));
+        }
+        else
+        {
+            useBackground(LoadTexture(path.c_str()), std::nullopt);
+        }
+    }
+
+    void Gameplay::useBackground(const Texture2D texture, std::optional<lulu::BackgroundChunks> chunks,
+                                 std::vector<RoomLoader::ChunkTexture> chunkTextures)
+    {
+        setBackground(texture);
+        chunks_.reset();
+
+        if (chunks)
+        {
+            const lulu::Vec2<float> screen = lulu::Vec2{GetScreenWidth(), GetScreenHeight()}.convert<float>();
+            chunks_ = std::make_unique<ChunkedBackground>(std::move(*chunks), screen);
+
+            // Precaricati dal RoomLoader: il primo frame della stanza non ha buchi
+            for (const auto& [chunk, chunkTexture] : chunkTextures)
+                chunks_->adopt(chunk, chunkTexture);
+        }
+        else
+        {
+            for (const auto& [chunk, chunkTexture] : chunkTextures)
+                UnloadTexture(chunkTexture);
+        }
+    }
+
+    void Gameplay::buildStaticLayer()
+    {
+        const lulu::TileMap& tiles = arena_->tiles();
+
+        // Di solito tutte le stanze usano lo stesso tileset: si carica una volta sola
+        if (tiles.visible() && tiles.tileset != tilesetPath_)
+        {
+            if (tileset_.id != 0)
+            {
+                UnloadTexture(tileset_);
+            }
+            tileset_ = LoadTexture(tiles.tileset.c_str());
+            tilesetPath_ = tiles.tileset;
+        }
+
+        // Sfondo normale: tutta la stanza in una texture. Sfondo a chunk: il mondo
+        // può essere enorme, quindi nella texture vanno solo i tile, e gli attori
+        // statici restano nella lista di disegno.
+        Rectangle bounds;
+        if (!chunks_)
+        {
+            const lulu::Vec2<float> world = worldSize();
+            bounds = {0, 0, world.x, world.y};
+        }
+        else if (tiles.visible())
+        {
+            const lulu::Vec2<float> extent = lulu::Vec2{tiles.columns, tiles.rows}.convert<float>() * tiles.tileSize;
+            bounds = {tiles.origin.x, tiles.origin.y, extent.x, extent.y};
+        }
+        else
+        {
+            static_.reset();
+            arena_->clearDirtyRegions();
+            return;
+        }
+
+        // Stanza delle stesse dimensioni (il caso comune): si riusa la texture
+        const Rectangle current = static_ ? static_->bounds() : Rectangle{};
+        if (static_ && current.x == std::floor(bounds.x) && current.y == std::floor(bounds.y) &&
+            current.width == std::ceil(bounds.x + bounds.width) - current.x &&
+            current.height == std::ceil(bounds.y + bounds.height) - current.y)
+        {
+            static_->invalidateAll();
+        }
+        else
+        {
+            static_.reset();
+            static_ = std::make_unique<StaticLayer>(bounds);
+        }
+        arena_->clearDirtyRegions();
+    }
+
+    bool Gameplay::bakesProps() const
+    {
+        return static_ && !chunks_;
+    }
+
+    void Gameplay::paintStatic(const Rectangle region)
+    {
+        if (!chunks_)
+        {
+            DrawTexture(background_, 0, 0, WHITE);
+        }
+
+        const lulu::TileMap& tiles = arena_->tiles();
+        if (tiles.visible())
+        {
+            StaticLayer::drawTiles(tiles, tileset_, region);
+        }
+
+        if (bakesProps())
+        {
+            // Stesso ordine del livello RL_GROUND della lista di disegno
+            renderList_.begin(region);
+            for (const auto& actor : arena_->actors())
+            {
+                if (actor->sprite() != lulu::NO_SPRITE && layerOf(*actor) == RL_GROUND)
+                {
+                    const auto [x, y] = actor->pos().convert<int>().convert<float>();
+                    renderList_.add(RL_GROUND, sprites_.get(actor->sprite()), {x, y});
+                }
+            }
+            renderList_.draw();
+        }
+    }
+
+    lulu::Vec2<float> Gameplay::worldSize() const
+    {
+        if (chunks_)
+        {
+            return chunks_->table().size;
+        }
+        if (background_.id != 0)
+        {
+            return lulu::Vec2{background_.width, background_.height}.convert<float>();
+        }
+        return arena_->pos() + arena_->size();
+    }
+
+    Rectangle Gameplay::updateCamera(const float alpha)
+    {
+        const lulu::Vec2<float> screen = lulu::Vec2{GetScreenWidth(), GetScreenHeight()}.convert<float>();
+        const lulu::Vec2<float> world = worldSize();
 
-        if (doorInfo.changeMusic)
+        lulu::Vec2<float> focus = world / 2.0f;
+        if (const lulu::Link* link = findLink())
         {
-            setMusic(doorInfo.destination);
+            focus = link->interpolatedPos(alpha) + link->size() / 2.0f;
         }
 
-        linkPtr->setPos(doorInfo.spawn);
-        arena_.spawn(std::move(linkPtr));
+        // La vista segue Link senza uscire dal mondo
+        const Rectangle view = followView(focus, screen, world);
+        camera_ = Camera2D{{0, 0}, {view.x, view.y}, 0.0f, 1.0f};
+        return view;
     }
 }
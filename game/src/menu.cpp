@@ -22,18 +22,14 @@ namespace game
             growing = true;
         transparency += growing ? 15 : -15;
 
-        for (const auto keys = activeInputs(); const auto key : keys)
+        if (activeInputs() & lulu::keyBit(lulu::K_ENTER))
         {
-            if (key == lulu::K_ENTER)
-            {
-                std::unique_ptr<GameScene> gameplay_scene = std::make_unique<Gameplay>(game_);
-                game_->switchScene(gameplay_scene);
-                break;
-            }
+            std::unique_ptr<GameScene> gameplay_scene = std::make_unique<Gameplay>(game_);
+            game_->switchScene(gameplay_scene);
         }
     }
 
-    void Menu::render()
+    void Menu::render(float)
     {
         BeginDrawing();
         ClearBackground(BLACK);
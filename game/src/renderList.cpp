@@ -0,0 +1,64 @@
+#include "renderList.hpp"
+#include <algorithm>
+
+namespace game
+{
+    namespace
+    {
+        // Chiave: livello (4 bit) | profondità (20 bit) | texture (8 bit)
+        constexpr int DEPTH_BITS = 20;
+        constexpr int TEXTURE_BITS = 8;
+        constexpr std::uint32_t MAX_DEPTH = (1u << DEPTH_BITS) - 1;
+
+        std::uint32_t sortKey(const RenderLayer layer, const float depth, const unsigned int texture)
+        {
+            const auto clamped = static_cast<std::uint32_t>(std::clamp(depth, 0.0f, static_cast<float>(MAX_DEPTH)));
+            return static_cast<std::uint32_t>(layer) << (DEPTH_BITS + TEXTURE_BITS)
+                 | clamped << TEXTURE_BITS
+                 | (texture & 0xff);
+        }
+    }
+
+    void RenderList::begin(const Rectangle view)
+    {
+        view_ = view;
+        items_.clear();
+        keys_.clear();
+        culled_ = 0;
+    }
+
+    void RenderList::add(const RenderLayer layer, const SpriteCache::Sprite& sprite, const Vector2 pos)
+    {
+        const float right = pos.x + sprite.source.width;
+        const float bottom = pos.y + sprite.source.height;
+        if (right <= view_.x || pos.x >= view_.x + view_.width || bottom <= view_.y || pos.y >= view_.y + view_.height)
+        {
+            ++culled_;
+            return;
+        }
+
+        // La profondità è il bordo inferiore, relativo alla vista: basta l'ordine dentro il frame
+        keys_.push_back({sortKey(layer, bottom - view_.y, sprite.texture.id), static_cast<std::uint32_t>(items_.size())});
+        items_.push_back({sprite, pos});
+    }
+
+    void RenderList::draw()
+    {
+        lulu::radixSort(keys_, scratch_);
+        for (const auto& [key, index] : keys_)
+        {
+            const auto& [sprite, pos] = items_[index];
+            DrawTextureRec(sprite.texture, sprite.source, pos, WHITE);
+        }
+    }
+
+    std::size_t RenderList::size() const
+    {
+        return items_.size();
+    }
+
+    std::size_t RenderList::culled() const
+    {
+        return culled_;
+    }
+} // namespace game
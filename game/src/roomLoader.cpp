@@ -0,0 +1,319 @@
+#include "roomLoader.hpp"
+#include "camera.hpp"
+#include "chunkedBackground.hpp"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace game
+{
+    namespace
+    {
+        // Carica un'immagine decodificata e la libera; texture vuota se l'immagine è vuota (sfondo a chunk, PNG illeggibile)
+        Texture2D upload(const Image image)
+        {
+            const Texture2D texture = image.data ? LoadTextureFromImage(image) : Texture2D{};
+            UnloadImage(image);
+            return texture;
+        }
+    }
+
+    RoomLoader::RoomLoader(const lulu::Atlas& atlas, const lulu::Vec2<float> viewSize)
+        : atlas_(atlas), viewSize_(viewSize), worker_([this](const std::stop_token& stop) { work(stop); })
+    {
+    }
+
+    RoomLoader::~RoomLoader()
+    {
+        // Prima si ferma il thread, poi si liberano le stanze (le texture vanno liberate qui, sul thread principale)
+        worker_.request_stop();
+        wake_.notify_all();
+        worker_.join();
+
+        for (auto& [path, entry] : rooms_)
+            release(entry);
+    }
+
+    RoomLoader::Decoded RoomLoader::decode(const std::string& path, const lulu::Vec2<float> spawn) const
+    {
+        const auto room = lulu::RoomData::load(path);
+
+        Decoded decoded;
+        decoded.arena = std::make_unique<lulu::Arena>(room);
+        decoded.music = room.scene.music;
+
+        // Uno sfondo a chunk non si decodifica mai per intero: lo carica il gameplay attorno alla camera
+        decoded.chunks = lulu::BackgroundChunks::find(room.scene.background);
+        if (!decoded.chunks)
+            decoded.background = LoadImage(room.scene.background.c_str());
+
+        // ...tranne i chunk che ChunkedBackground chiederà subito: altrimenti il primo frame avrebbe dei buchi
+        if (decoded.chunks)
+        {
+            const lulu::BackgroundChunks& table = *decoded.chunks;
+            const Rectangle view = followView(spawn, viewSize_, table.size);
+            const auto around = table.range({view.x, view.y}, {view.width, view.height}, ChunkedBackground::MARGIN);
+            for (int row = around.firstRow; row <= around.lastRow; ++row)
+            {
+                for (int column = around.firstColumn; column <= around.lastColumn; ++column)
+                {
+                    decoded.chunkImages.emplace_back(table.index(column, row), LoadImage(table.path(column, row).c_str()));
+                }
+            }
+        }
+
+        // Una sola immagine per sprite, anche se molti attori la condividono
+        std::vector<lulu::SpriteId> sprites;
+        for (const auto& actor : decoded.arena->actors())
+        {
+            if (actor->sprite() != lulu::NO_SPRITE && !atlas_.region(actor->sprite()))
+                sprites.push_back(actor->sprite());
+        }
+        std::ranges::sort(sprites);
+        const auto [first, last] = std::ranges::unique(sprites);
+        sprites.erase(first, last);
+
+        for (const lulu::SpriteId sprite : sprites)
+            decoded.sprites.emplace_back(sprite, LoadImage(lulu::SpriteRegistry::path(sprite).c_str()));
+
+        return decoded;
+    }
+
+    void RoomLoader::work(const std::stop_token& stop)
+    {
+        while (true)
+        {
+            std::string path;
+            lulu::Vec2<float> spawn{};
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, stop, [this] { return !queue_.empty(); });
+                if (stop.stop_requested()) return;
+
+                path = std::move(queue_.front());
+                queue_.pop_front();
+                if (const auto it = rooms_.find(path); it != rooms_.end())
+                    spawn = it->second.spawn;
+            }
+
+            // Fuori dal lock: il thread principale continua a girare
+            std::optional<Decoded> decoded;
+            try
+            {
+                decoded = decode(path, spawn);
+            }
+            catch (const std::exception& e)
+            {
+                TraceLog(LOG_WARNING, "Preloading %s failed: %s", path.c_str(), e.what());
+            }
+
+            {
+                std::scoped_lock lock(mutex_);
+                const auto it = rooms_.find(path);
+                if (it != rooms_.end() && !it->second.discarded && decoded)
+                {
+                    it->second.decoded = std::move(decoded);
+                }
+                else
+                {
+                    // Scartata nel frattempo, o fallita: take() ricadrà sul caricamento sincrono
+                    if (decoded)
+                    {
+                        UnloadImage(decoded->background);
+                        for (const auto& [chunk, image] : decoded->chunkImages)
+                            UnloadImage(image);
+                        for (const auto& [sprite, image] : decoded->sprites)
+                            UnloadImage(image);
+                    }
+                    if (it != rooms_.end())
+                        rooms_.erase(it);
+                }
+            }
+            ready_.notify_all();
+        }
+    }
+
+    void RoomLoader::release(Entry& entry)
+    {
+        if (entry.decoded)
+        {
+            if (!entry.background)
+                UnloadImage(entry.decoded->background);
+            for (const auto& [chunk, image] : entry.decoded->chunkImages)
+                UnloadImage(image);
+            entry.decoded->chunkImages.clear();
+            for (const auto& [sprite, image] : entry.decoded->sprites)
+                UnloadImage(image);
+            entry.decoded->sprites.clear();
+        }
+        for (const auto& [chunk, texture] : entry.chunkTextures)
+            UnloadTexture(texture);
+        entry.chunkTextures.clear();
+        if (entry.background)
+        {
+            UnloadTexture(*entry.background);
+            entry.background.reset();
+        }
+    }
+
+    void RoomLoader::preload(const std::vector<Destination>& destinations)
+    {
+        {
+            std::scoped_lock lock(mutex_);
+
+            // Le stanze non più raggiungibili vengono liberate (o scartate, se il thread ci sta lavorando)
+            for (auto it = rooms_.begin(); it != rooms_.end();)
+            {
+                if (std::ranges::find(destinations, it->first, &Destination::path) != destinations.end())
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (const auto queued = std::ranges::find(queue_, it->first); queued != queue_.end())
+                {
+                    queue_.erase(queued);
+                }
+                else if (!it->second.decoded)
+                {
+                    it->second.discarded = true;
+                    ++it;
+                    continue;
+                }
+
+                release(it->second);
+                it = rooms_.erase(it);
+            }
+
+            for (const auto& [path, spawn] : destinations)
+            {
+                const auto [it, inserted] = rooms_.try_emplace(path);
+                it->second.discarded = false;
+                if (inserted)
+                {
+                    it->second.spawn = spawn;
+                    queue_.push_back(path);
+                }
+            }
+        }
+        wake_.notify_all();
+    }
+
+    void RoomLoader::pump(SpriteCache& sprites, const double budget)
+    {
+        const double start = GetTime();
+
+        // Immagini prese da una stanza: il lock non resta tenuto durante il caricamento su GPU
+        struct Uploads
+        {
+            Entry* entry; // Stabile: il thread non tocca più le stanze già decodificate
+            std::optional<Image> background;
+            std::vector<std::pair<std::size_t, Image>> chunkImages;
+            std::vector<std::pair<lulu::SpriteId, Image>> sprites;
+            std::optional<Texture2D> backgroundTexture;
+            std::vector<ChunkTexture> chunkTextures;
+        };
+
+        std::vector<Uploads> pending;
+        {
+            std::scoped_lock lock(mutex_);
+            for (auto& [path, entry] : rooms_)
+            {
+                if (!entry.decoded || entry.discarded) continue;
+
+                Uploads& uploads = pending.emplace_back(&entry);
+                if (!entry.background)
+                    uploads.background = std::exchange(entry.decoded->background, Image{});
+                uploads.chunkImages = std::exchange(entry.decoded->chunkImages, {});
+                uploads.sprites = std::exchange(entry.decoded->sprites, {});
+            }
+        }
+
+        // Almeno un caricamento per chiamata, poi solo finché resta budget
+        bool inBudget = true;
+        for (auto& uploads : pending)
+        {
+            if (inBudget && uploads.background)
+            {
+                uploads.backgroundTexture = upload(*uploads.background);
+                uploads.background.reset();
+                inBudget = GetTime() - start < budget;
+            }
+
+            while (inBudget && !uploads.chunkImages.empty())
+            {
+                const auto [chunk, image] = uploads.chunkImages.back();
+                uploads.chunkImages.pop_back();
+                uploads.chunkTextures.emplace_back(chunk, upload(image));
+                inBudget = GetTime() - start < budget;
+            }
+
+            while (inBudget && !uploads.sprites.empty())
+            {
+                const auto [sprite, image] = uploads.sprites.back();
+                uploads.sprites.pop_back();
+                sprites.upload(sprite, image);
+                inBudget = GetTime() - start < budget;
+            }
+        }
+
+        // Le texture vanno nelle stanze; le immagini fuori budget tornano in attesa del prossimo frame
+        std::scoped_lock lock(mutex_);
+        for (auto& uploads : pending)
+        {
+            Entry& entry = *uploads.entry;
+            if (uploads.backgroundTexture)
+                entry.background = uploads.backgroundTexture;
+            if (uploads.background)
+                entry.decoded->background = *uploads.background;
+            std::ranges::move(uploads.chunkTextures, std::back_inserter(entry.chunkTextures));
+            entry.decoded->chunkImages = std::move(uploads.chunkImages);
+            entry.decoded->sprites = std::move(uploads.sprites);
+        }
+    }
+
+    std::optional<RoomLoader::Room> RoomLoader::take(const std::string& path,
+                                                     SpriteCache& sprites)
+    {
+        std::unique_lock lock(mutex_);
+        auto it = rooms_.find(path);
+        if (it == rooms_.end()) return std::nullopt;
+
+        if (!it->second.decoded)
+        {
+            // Ancora in coda: il thread non ci ha lavorato, conviene il caricamento sincrono
+            if (const auto queued = std::ranges::find(queue_, path); queued != queue_.end())
+            {
+                queue_.erase(queued);
+                rooms_.erase(it);
+                return std::nullopt;
+            }
+
+            // In decodifica: manca poco, si aspetta il thread
+            ready_.wait(lock, [&]
+            {
+                it = rooms_.find(path);
+                return it == rooms_.end() || it->second.decoded.has_value();
+            });
+            if (it == rooms_.end()) return std::nullopt;
+        }
+
+        Entry& entry = it->second;
+        Decoded& decoded = *entry.decoded;
+
+        // Quello che pump() non ha fatto in tempo a caricare si carica ora
+        if (!entry.background)
+            entry.background = upload(decoded.background);
+        for (const auto& [chunk, image] : decoded.chunkImages)
+            entry.chunkTextures.emplace_back(chunk, upload(image));
+        decoded.chunkImages.clear();
+        for (const auto& [sprite, image] : decoded.sprites)
+            sprites.upload(sprite, image);
+        decoded.sprites.clear();
+
+        Room room{std::move(decoded.arena), *entry.background, std::move(decoded.music), std::move(decoded.chunks),
+                  std::move(entry.chunkTextures)};
+        rooms_.erase(it);
+        return room;
+    }
+} // namespace game
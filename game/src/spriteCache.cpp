@@ -0,0 +1,84 @@
+#include "spriteCache.hpp"
+#include <filesystem>
+
+namespace game
+{
+    SpriteCache::SpriteCache(const std::string& atlasPath)
+    {
+        if (!std::filesystem::exists(atlasPath)) return;
+
+        try
+        {
+            atlas_ = lulu::Atlas::load(atlasPath);
+        }
+        catch (const std::exception& e)
+        {
+            TraceLog(LOG_WARNING, "Ignoring sprite atlas: %s", e.what());
+            return;
+        }
+
+        for (const auto& page : atlas_.pages())
+        {
+            const Texture2D texture = LoadTexture(page.image.c_str());
+            if (texture.id == 0)
+            {
+                // Pagine incomplete: meglio nessun atlante che sprite mancanti
+                TraceLog(LOG_WARNING, "Ignoring sprite atlas: missing page %s", page.image.c_str());
+                for (const Texture2D& loaded : pages_)
+                    UnloadTexture(loaded);
+                pages_.clear();
+                atlas_ = {};
+                return;
+            }
+            pages_.push_back(texture);
+        }
+    }
+
+    SpriteCache::~SpriteCache()
+    {
+        for (const Texture2D& page : pages_)
+            UnloadTexture(page);
+        for (const auto& texture : textures_)
+            if (texture) UnloadTexture(*texture);
+    }
+
+    const lulu::Atlas& SpriteCache::atlas() const
+    {
+        return atlas_;
+    }
+
+    bool SpriteCache::contains(const lulu::SpriteId sprite) const
+    {
+        return atlas_.region(sprite) || (sprite < textures_.size() && textures_[sprite]);
+    }
+
+    void SpriteCache::upload(const lulu::SpriteId sprite, const Image image)
+    {
+        if (!contains(sprite) && image.data)
+        {
+            // Gli id sono densi: la cache è un semplice array
+            if (sprite >= textures_.size())
+                textures_.resize(lulu::SpriteRegistry::size());
+            textures_[sprite] = LoadTextureFromImage(image);
+        }
+        UnloadImage(image);
+    }
+
+    SpriteCache::Sprite SpriteCache::get(const lulu::SpriteId sprite)
+    {
+        if (const lulu::AtlasRegion* region = atlas_.region(sprite))
+        {
+            return {pages_[region->page], {region->pos.x, region->pos.y, region->size.x, region->size.y}};
+        }
+
+        if (sprite >= textures_.size())
+            textures_.resize(lulu::SpriteRegistry::size());
+
+        auto& texture = textures_[sprite];
+        if (!texture)
+        {
+            texture = LoadTexture(lulu::SpriteRegistry::path(sprite).c_str());
+        }
+        return {*texture, {0, 0, static_cast<float>(texture->width), static_cast<float>(texture->height)}};
+    }
+} // namespace game
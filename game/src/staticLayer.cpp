@@ -0,0 +1,127 @@
+#include "staticLayer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game
+{
+    namespace
+    {
+        bool overlaps(const Rectangle a, const Rectangle b)
+        {
+            return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+        }
+
+        Rectangle merge(const Rectangle a, const Rectangle b)
+        {
+            const float left = std::min(a.x, b.x);
+            const float top = std::min(a.y, b.y);
+            const float right = std::max(a.x + a.width, b.x + b.width);
+            const float bottom = std::max(a.y + a.height, b.y + b.height);
+            return {left, top, right - left, bottom - top};
+        }
+    }
+
+    StaticLayer::StaticLayer(const Rectangle bounds)
+    {
+        // Pixel interi: la texture si disegna senza filtraggio tra due pixel
+        const float left = std::floor(bounds.x);
+        const float top = std::floor(bounds.y);
+        bounds_ = {left, top, std::ceil(bounds.x + bounds.width) - left, std::ceil(bounds.y + bounds.height) - top};
+
+        target_ = LoadRenderTexture(static_cast<int>(bounds_.width), static_cast<int>(bounds_.height));
+        invalidateAll();
+    }
+
+    StaticLayer::~StaticLayer()
+    {
+        UnloadRenderTexture(target_);
+    }
+
+    void StaticLayer::drawTiles(const lulu::TileMap& tiles, const Texture2D tileset, const Rectangle region)
+    {
+        const auto cells = tiles.range({region.x, region.y}, {region.width, region.height});
+        for (int row = cells.firstRow; row <= cells.lastRow; ++row)
+        {
+            for (int column = cells.firstColumn; column <= cells.lastColumn; ++column)
+            {
+                const lulu::TileMap::Tile* tile = tiles.at(column, row);
+                if (!tile || !tile->source) continue;
+
+                const auto [x, y] = tiles.cellPos(column, row);
+                DrawTexturePro(tileset,
+                               {tile->source->x, tile->source->y, tiles.sourceSize, tiles.sourceSize},
+                               {x, y, tiles.tileSize, tiles.tileSize},
+                               {0, 0}, 0.0f, WHITE);
+            }
+        }
+    }
+
+    Rectangle StaticLayer::bounds() const
+    {
+        return bounds_;
+    }
+
+    void StaticLayer::invalidate(const Rectangle region)
+    {
+        // Allargato ai pixel interi e tagliato alla texture: lo scissor lavora in pixel
+        const float left = std::floor(std::max(region.x, bounds_.x));
+        const float top = std::floor(std::max(region.y, bounds_.y));
+        const float right = std::ceil(std::min(region.x + region.width, bounds_.x + bounds_.width));
+        const float bottom = std::ceil(std::min(region.y + region.height, bounds_.y + bounds_.height));
+        if (right <= left || bottom <= top) return;
+
+        // I rettangoli che si sovrappongono diventano uno: nessun pixel viene ridisegnato due volte
+        Rectangle added{left, top, right - left, bottom - top};
+        for (auto it = dirty_.begin(); it != dirty_.end();)
+        {
+            if (overlaps(*it, added))
+            {
+                added = merge(*it, added);
+                dirty_.erase(it);
+                it = dirty_.begin();
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        dirty_.push_back(added);
+
+        if (dirty_.size() > MAX_REGIONS)
+            invalidateAll();
+    }
+
+    void StaticLayer::invalidateAll()
+    {
+        dirty_.assign(1, bounds_);
+    }
+
+    void StaticLayer::update(const Painter& paint)
+    {
+        if (dirty_.empty()) return;
+
+        // Una camera con target nell'angolo della texture porta le coordinate del mondo nella texture
+        const Camera2D local{{0, 0}, {bounds_.x, bounds_.y}, 0.0f, 1.0f};
+
+        BeginTextureMode(target_);
+        for (const Rectangle& region : dirty_)
+        {
+            BeginScissorMode(static_cast<int>(region.x - bounds_.x), static_cast<int>(region.y - bounds_.y),
+                             static_cast<int>(region.width), static_cast<int>(region.height));
+            ClearBackground(BLANK); // Rispetta lo scissor: si cancella solo il rettangolo
+            BeginMode2D(local);
+            paint(region);
+            EndMode2D();
+            EndScissorMode();
+        }
+        EndTextureMode();
+
+        dirty_.clear();
+    }
+
+    void StaticLayer::draw() const
+    {
+        // Le RenderTexture di OpenGL sono capovolte: altezza negativa nella sorgente
+        DrawTextureRec(target_.texture, {0, 0, bounds_.width, -bounds_.height}, {bounds_.x, bounds_.y}, WHITE);
+    }
+} // namespace game
@@ -0,0 +1,299 @@
+// Simulazione headless: carica una stanza, la fa avanzare con input da script
+// alla massima velocità possibile e riporta i tick al secondo.
+// Non usa raylib: gira anche su macchine senza display né audio (CI, soak test).
+//
+// Con --record salva la sessione in un InputLog; con --replay rigioca un
+// InputLog (registrato qui o dal gioco) verificando a ogni tick l'hash
+// dello stato: la prima divergenza viene segnalata con il numero del tick.
+
+#include "lulu.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Un passo dello script: tieni premuti certi tasti per un certo numero di tick
+     */
+    struct ScriptStep
+    {
+        int ticks;
+        lulu::KeyMask keys;
+    };
+
+    struct Options
+    {
+        std::string room = "assets/dungeon/rooms/hall.json";
+        std::string script;
+        long long ticks = 100000;
+        lulu::Vec2<float> spawn{375, 400};
+        std::optional<std::uint64_t> seed;
+        std::string record;
+        std::string replay;
+        bool quiet = false;
+    };
+
+    const std::unordered_map<std::string, lulu::Key> KEY_NAMES{
+        {"SPACE", lulu::K_SPACE}, {"A", lulu::K_A}, {"D", lulu::K_D}, {"S", lulu::K_S}, {"W", lulu::K_W},
+        {"ENTER", lulu::K_ENTER}, {"ESCAPE", lulu::K_ESCAPE}, {"RIGHT", lulu::K_RIGHT}, {"LEFT", lulu::K_LEFT},
+        {"DOWN", lulu::K_DOWN}, {"UP", lulu::K_UP}
+    };
+
+    // Script di default: gira per la stanza in tutte le direzioni e attacca
+    constexpr lulu::KeyMask W = lulu::keyBit(lulu::K_W), A = lulu::keyBit(lulu::K_A);
+    constexpr lulu::KeyMask S = lulu::keyBit(lulu::K_S), D = lulu::keyBit(lulu::K_D);
+    constexpr lulu::KeyMask SPACE = lulu::keyBit(lulu::K_SPACE);
+
+    const std::vector<ScriptStep> DEFAULT_SCRIPT{
+        {20, W}, {1, SPACE}, {6, 0},
+        {20, D}, {1, SPACE}, {6, 0},
+        {20, S}, {1, SPACE}, {6, 0},
+        {20, A}, {1, SPACE}, {6, 0},
+        {15, W | D}, {15, S | A},
+        {15, W | A}, {15, S | D}
+    };
+
+    void printUsage(const char* program)
+    {
+        std::cerr << "Usage: " << program << " [room.json] [options]\n"
+                  << "  --ticks N       number of ticks to simulate (default 100000)\n"
+                  << "  --script FILE   input script, one step per line: <ticks> [KEY...]\n"
+                  << "                  keys: SPACE W A S D UP DOWN LEFT RIGHT ENTER ESCAPE\n"
+                  << "  --spawn X Y     Link spawn position (default 375 400)\n"
+                  << "  --seed N        RNG seed (default: the room's \"seed\", else a fixed one)\n"
+                  << "  --record FILE   save the session as an input log\n"
+                  << "  --replay FILE   replay an input log, checking the state hash every tick\n"
+                  << "                  (room, seed, spawn and tick count come from the log)\n"
+                  << "  --quiet         print only the ticks/s figure\n";
+    }
+
+    /**
+     * @brief Legge uno script di input
+     *
+     * Formato: una riga per passo, "<tick> [TASTO...]". Righe vuote e
+     * commenti (#) vengono ignorati. Lo script viene ripetuto in loop.
+     */
+    std::vector<ScriptStep> loadScript(const std::string& path)
+    {
+        std::ifstream f(path);
+        if (!f.is_open())
+        {
+            throw std::runtime_error("Could not open script file: " + path);
+        }
+
+        std::vector<ScriptStep> script;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(f, line))
+        {
+            ++lineNumber;
+            if (const auto comment = line.find('#'); comment != std::string::npos)
+                line.erase(comment);
+
+            std::istringstream in(line);
+            ScriptStep step{};
+            if (!(in >> step.ticks)) continue;
+
+            for (std::string name; in >> name;)
+            {
+                const auto it = KEY_NAMES.find(name);
+                if (it == KEY_NAMES.end())
+                {
+                    throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown key " + name);
+                }
+                step.keys |= lulu::keyBit(it->second);
+            }
+
+            if (step.ticks > 0)
+                script.push_back(std::move(step));
+        }
+
+        if (script.empty())
+        {
+            throw std::runtime_error("Empty script: " + path);
+        }
+        return script;
+    }
+
+    /**
+     * @brief La simulazione della sessione: stanza corrente più Link
+     *
+     * Segue le porte come fa il gioco (Gameplay::changeRoom), così una
+     * registrazione fatta giocando può attraversare più stanze.
+     */
+    class Session
+    {
+        std::unique_ptr<lulu::Arena> arena_;
+
+    public:
+        Session(const std::string& room, const std::optional<std::uint64_t> seed, const lulu::Vec2<float> spawn)
+            : arena_(std::make_unique<lulu::Arena>(room, seed))
+        {
+            arena_->spawn(std::make_unique<lulu::Link>(spawn));
+        }
+
+        [[nodiscard]] const lulu::Arena& arena() const { return *arena_; }
+
+        /** @brief Avanza di un tick e restituisce l'hash dello stato (prima di un eventuale cambio stanza) */
+        std::uint64_t tick(const lulu::KeyMask keys)
+        {
+            arena_->tick(keys);
+            const std::uint64_t hash = arena_->stateHash();
+
+            lulu::Link* link = arena_->first<lulu::Link>();
+            if (!link) return hash;
+
+            for (const auto& [target, direction] : arena_->collisions(link->handle()))
+            {
+                if (const auto* door = arena_->get<lulu::Door>(target))
+                {
+                    const std::string destination = door->destination();
+                    const lulu::Vec2<float> spawn = door->spawn();
+
+                    auto linkPtr = arena_->kill(link);
+                    arena_ = std::make_unique<lulu::Arena>(destination);
+                    arena_->spawn(std::move(linkPtr), spawn);
+                    break;
+                }
+            }
+            return hash;
+        }
+    };
+
+    bool parseOptions(const int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--ticks" && i + 1 < argc)
+                options.ticks = std::atoll(argv[++i]);
+            else if (arg == "--script" && i + 1 < argc)
+                options.script = argv[++i];
+            else if (arg == "--spawn" && i + 2 < argc)
+            {
+                options.spawn.x = std::strtof(argv[++i], nullptr);
+                options.spawn.y = std::strtof(argv[++i], nullptr);
+            }
+            else if (arg == "--seed" && i + 1 < argc)
+                options.seed = std::strtoull(argv[++i], nullptr, 0);
+            else if (arg == "--record" && i + 1 < argc)
+                options.record = argv[++i];
+            else if (arg == "--replay" && i + 1 < argc)
+                options.replay = argv[++i];
+            else if (arg == "--quiet")
+                options.quiet = true;
+            else if (arg == "--help" || arg == "-h" || arg.starts_with("--"))
+                return false;
+            else
+                options.room = arg;
+        }
+        return true;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        std::optional<lulu::InputLog> replay;
+        if (!options.replay.empty())
+        {
+            replay = lulu::InputLog::load(options.replay);
+            options.room = replay->room();
+            options.seed = replay->seed();
+            options.spawn = replay->spawn();
+            options.ticks = static_cast<long long>(replay->tickCount());
+        }
+
+        const std::vector<ScriptStep> script = options.script.empty() ? DEFAULT_SCRIPT : loadScript(options.script);
+
+        Session session(options.room, options.seed, options.spawn);
+
+        std::optional<lulu::InputLog> record;
+        if (!options.record.empty())
+            record.emplace(options.room, session.arena().seed(), options.spawn);
+
+        long long divergence = -1;
+        const auto start = std::chrono::steady_clock::now();
+        if (replay)
+        {
+            long long tick = 0;
+            for (const auto& [keys, ticks] : replay->runs())
+            {
+                for (std::uint32_t i = 0; i < ticks; ++i, ++tick)
+                {
+                    if (!replay->matches(tick, session.tick(keys)) && divergence < 0)
+                        divergence = tick;
+                }
+            }
+        }
+        else
+        {
+            std::size_t step = 0;
+            int stepTick = 0;
+
+            for (long long tick = 0; tick < options.ticks; ++tick)
+            {
+                const std::uint64_t hash = session.tick(script[step].keys);
+                if (record)
+                    record->record(script[step].keys, hash);
+
+                if (++stepTick >= script[step].ticks)
+                {
+                    stepTick = 0;
+                    step = (step + 1) % script.size();
+                }
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const double tps = static_cast<double>(options.ticks) / elapsed.count();
+
+        if (record)
+            record->save(options.record);
+
+        if (divergence >= 0)
+            std::cerr << "replay diverged at tick " << divergence << '\n';
+
+        if (options.quiet)
+        {
+            std::cout << tps << '\n';
+            return divergence >= 0 ? 2 : 0;
+        }
+
+        const lulu::Arena& arena = session.arena();
+        const lulu::Link* link = arena.first<lulu::Link>();
+        std::cout << "room:     " << options.room << '\n'
+                  << "seed:     " << options.seed.value_or(arena.seed()) << '\n'
+                  << "ticks:    " << options.ticks << '\n'
+                  << "elapsed:  " << elapsed.count() << " s\n"
+                  << "ticks/s:  " << tps << '\n'
+                  << "actors:   " << arena.actors().size() << '\n'
+                  << "link hp:  " << (link ? link->hp() : 0.0f) << '\n'
+                  << "room io:  " << lulu::RoomData::loadCount() << " file reads\n";
+        if (replay)
+            std::cout << "replay:   " << (divergence >= 0 ? "DIVERGED" : "ok") << '\n';
+
+        return divergence >= 0 ? 2 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Array impacchettato (SoA) di rettangoli da testare in blocco contro un AABB
+   *
+   * Le quattro componenti stanno in array separati e contigui, così il
+   * kernel le carica 4 (SSE2) o 8 (AVX) alla volta. I buffer vengono
+   * riusati tra una query e l'altra: clear() non libera memoria.
+   */
+  class AabbBatch final
+  {
+    std::vector<float> x_, y_, w_, h_;
+
+  public:
+    void clear();
+    void push(Vec2<float> pos, Vec2<float> size);
+
+    [[nodiscard]] std::size_t size() const { return x_.size(); }
+    [[nodiscard]] bool empty() const { return x_.empty(); }
+
+    [[nodiscard]] const float* x() const { return x_.data(); }
+    [[nodiscard]] const float* y() const { return y_.data(); }
+    [[nodiscard]] const float* w() const { return w_.data(); }
+    [[nodiscard]] const float* h() const { return h_.data(); }
+  };
+
+  /**
+   * @brief Testa un AABB contro tutti i rettangoli di un batch
+   *
+   * Per ogni rettangolo i scrive in directions[i] lo stesso risultato di
+   * Actor::checkCollision (D_NONE se non c'è sovrapposizione, altrimenti il
+   * lato di penetrazione minima), bit per bit, e accende il bit i di
+   * hitMask se c'è contatto. hitMask deve avere almeno (size + 63) / 64
+   * parole; directions almeno size elementi.
+   *
+   * Usa AVX (8 alla volta) o SSE2 (4 alla volta) se il compilatore li
+   * abilita (-march=native), altrimenti ricade sulla versione scalare.
+   *
+   * @return Numero di rettangoli in contatto
+   */
+  std::size_t overlapBatch(Vec2<float> pos, Vec2<float> size, const AabbBatch& batch,
+                           std::uint64_t* hitMask, Direction* directions);
+
+  /** @brief Versione scalare di overlapBatch (riferimento e fallback) */
+  std::size_t overlapBatchScalar(Vec2<float> pos, Vec2<float> size, const AabbBatch& batch,
+                                 std::uint64_t* hitMask, Direction* directions);
+
+  /** @brief Set di istruzioni usato da overlapBatch ("avx", "sse2" o "scalar") */
+  const char* overlapBatchIsa();
+} // namespace lulu
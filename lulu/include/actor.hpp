@@ -1,16 +1,22 @@
 #pragma once
+#include "spriteRegistry.hpp"
+#include "transformStore.hpp"
 #include "types.hpp"
+#include <memory>
+#include <memory_resource>
 #include <string>
 
 namespace lulu
 {
   class Arena;
+  class Movable;
+  struct CharacterConfig;
 
   /**
    * @brief Classe base per tutti gli oggetti presenti nell'arena di gioco
    *
    * Un Actor rappresenta qualsiasi entità che ha:
-   * - Una posizione e dimensione nello spazio 2D
+   * - Una posizione, una dimensione e una velocità nello spazio 2D
    * - Una sprite grafica (opzionale)
    * - La capacità di rilevare collisioni con altri attori
    * - La capacità di reagire alle collisioni
@@ -20,10 +26,56 @@ namespace lulu
   class Actor
   {
   protected:
-    Vec2<float> pos_; // Posizione nell'arena (angolo in alto a sinistra)
-    Vec2<float> size_{}; // Dimensioni del rettangolo di collisione
-    std::string sprite_; // Percorso del file immagine da renderizzare
+    SpriteId sprite_; // Sprite da renderizzare (NO_SPRITE se invisibile)
     Arena* arena_; // Puntatore all'arena che contiene questo attore
+    std::uint8_t kind_{AK_NONE}; // Bitmask di ActorKind, impostata dai costruttori
+
+    /**
+     * @brief Sposta l'attore di un delta (movimento normale, interpolato dal renderer)
+     */
+    void translate(Vec2<float> delta);
+
+    /**
+     * @brief Porta l'attore in una posizione (es: risoluzione di una collisione)
+     *
+     * A differenza di setPos non è un teletrasporto: la posizione del tick
+     * precedente resta quella di prima, quindi il renderer interpola.
+     */
+    void moveTo(Vec2<float> pos);
+
+    /** @brief Cambia le dimensioni del rettangolo di collisione */
+    void setSize(Vec2<float> size);
+
+    /** @brief Cambia la velocità di movimento */
+    void setSpeed(Vec2<float> speed);
+
+    /**
+     * @brief Cambia la sprite (es: una porta che si apre)
+     *
+     * Gli attori statici vengono disegnati nello sfondo composto della
+     * stanza: il loro rettangolo viene segnalato all'arena come da
+     * ridisegnare (vedi Arena::invalidate). I Movable possono assegnare
+     * sprite_ direttamente.
+     */
+    void setSprite(SpriteId sprite);
+
+  private:
+    friend class Arena;
+
+    // Geometria dell'attore: vive solo nel TransformStore dell'arena,
+    // all'indice transform_ (assegnato e aggiornato dall'arena). Gli accessor
+    // la leggono da lì, quindi valgono solo mentre l'attore è in un'arena.
+    TransformStore* transforms_{nullptr};
+    std::uint32_t transform_{0};
+
+    // Geometria fuori da un'arena: quella data dal costruttore, o quella
+    // salvata da Arena::kill. Arena::insert la copia nello store.
+    Vec2<float> spawnPos_;
+    Vec2<float> spawnSize_{};
+    Vec2<float> spawnSpeed_{};
+
+    ActorHandle handle_{};    // Assegnato dall'Arena allo spawn
+    bool pendingKill_{false}; // Rimozione chiesta all'Arena, effettiva a fine tick
 
   public:
     /**
@@ -33,20 +85,22 @@ namespace lulu
      *
      * @param pos Posizione iniziale
      * @param size Dimensioni del rettangolo di collisione
-     * @param sprite Percorso dell'immagine (opzionale)
+     * @param sprite Percorso dell'immagine (opzionale), internato in uno SpriteId
+     * @param speed Velocità in pixel per tick (zero per gli attori statici)
      */
-    Actor(Vec2<float> pos, Vec2<float> size, const std::string& sprite = "");
+    Actor(Vec2<float> pos, Vec2<float> size, const std::string& sprite = "", Vec2<float> speed = {});
 
     /**
-     * @brief Costruttore per attori complessi che caricano da JSON
+     * @brief Costruttore per attori complessi descritti da un CharacterConfig
      *
      * Usato per giocatore, nemici e personaggi con configurazione complessa.
-     * Il file JSON deve contenere una sezione "actor" con sprite, size, ecc.
+     * Prende sprite e dimensioni dalla sezione "actor" del descrittore, la
+     * velocità dalla sezione "movable".
      *
-     * @param pos Posizione iniziale (sovrascrive quella nel JSON)
-     * @param configPath Percorso del file di configurazione JSON
+     * @param pos Posizione iniziale
+     * @param config Descrittore del personaggio (vedi CharacterConfig::load)
      */
-    explicit Actor(Vec2<float> pos, const std::string& configPath);
+    Actor(Vec2<float> pos, const CharacterConfig& config);
 
     /**
      * @brief Distruttore virtuale per ereditarietà corretta
@@ -56,17 +110,79 @@ namespace lulu
     // === GETTERS ===
 
     /** @brief Restituisce la posizione corrente */
-    [[nodiscard]] const Vec2<float>& pos() const;
+    [[nodiscard]] Vec2<float> pos() const;
+
+    /**
+     * @brief Restituisce la posizione interpolata tra il tick precedente e quello corrente
+     *
+     * Il renderer può girare più veloce della simulazione: tra due tick
+     * disegna l'attore in una posizione intermedia.
+     *
+     * @param alpha Frazione di tick trascorsa (0 = tick precedente, 1 = tick corrente)
+     */
+    [[nodiscard]] Vec2<float> interpolatedPos(float alpha) const;
 
     /** @brief Restituisce le dimensioni del rettangolo di collisione */
-    [[nodiscard]] const Vec2<float>& size() const;
+    [[nodiscard]] Vec2<float> size() const;
 
-    /** @brief Restituisce il percorso della sprite */
-    [[nodiscard]] const std::string& sprite() const;
+    /** @brief Restituisce la velocità di movimento (pixel per tick) */
+    [[nodiscard]] Vec2<float> speed() const;
+
+    /** @brief Restituisce la sprite corrente (percorso tramite SpriteRegistry::path) */
+    [[nodiscard]] SpriteId sprite() const;
 
     /** @brief Restituisce l'arena che contiene questo attore */
     [[nodiscard]] Arena* arena() const;
 
+    /** @brief Riferimento stabile all'attore nella sua arena (non valido se non spawnato) */
+    [[nodiscard]] ActorHandle handle() const;
+
+    /** @brief L'attore sta per essere rimosso dall'arena (vedi Arena::despawn) */
+    [[nodiscard]] bool isPendingKill() const;
+
+    // === TIPO DELL'ATTORE ===
+
+    /** @brief Restituisce la bitmask di ActorKind dell'attore */
+    [[nodiscard]] std::uint8_t kind() const;
+
+    /** @brief Controlla se l'attore appartiene a una categoria */
+    [[nodiscard]] bool is(ActorKind kind) const;
+
+    /**
+     * @brief Downcast senza RTTI basato sulla categoria
+     *
+     * T deve dichiarare `static constexpr ActorKind KIND`: un singolo bit
+     * impostato solo dal costruttore di T, così che ogni attore con quel bit
+     * sia davvero un T (o una sua sottoclasse). Il cast non è controllato:
+     * una categoria condivisa da più tipi, come AK_ENEMY, darebbe un
+     * comportamento indefinito sul primo attore di un altro tipo.
+     *
+     * @return L'attore come T, oppure nullptr se non è di tipo T
+     */
+    template <typename T>
+    [[nodiscard]] T* as()
+    {
+      static_assert(std::has_single_bit(static_cast<unsigned>(T::KIND)), "T::KIND must be a single ActorKind bit");
+      return is(T::KIND) ? static_cast<T*>(this) : nullptr;
+    }
+
+    template <typename T>
+    [[nodiscard]] const T* as() const
+    {
+      static_assert(std::has_single_bit(static_cast<unsigned>(T::KIND)), "T::KIND must be a single ActorKind bit");
+      return is(T::KIND) ? static_cast<const T*>(this) : nullptr;
+    }
+
+    /**
+     * @brief Restituisce la parte Movable dell'attore
+     *
+     * Movable è un mixin che non deriva da Actor, quindi non basta uno
+     * static_cast: le sottoclassi mobili sovrascrivono questo metodo.
+     *
+     * @return Puntatore a Movable, oppure nullptr se l'attore è statico
+     */
+    [[nodiscard]] virtual Movable* asMovable();
+
     // === SETTERS ===
 
     /**
@@ -77,6 +193,10 @@ namespace lulu
 
     /**
      * @brief Cambia la posizione dell'attore
+     *
+     * È un teletrasporto: anche la posizione precedente viene aggiornata,
+     * così il renderer non interpola attraverso la stanza.
+     *
      * @param pos Nuova posizione
      */
     void setPos(Vec2<float> pos);
@@ -104,5 +224,53 @@ namespace lulu
      * @param collision Informazioni sulla collisione (chi e da dove)
      */
     virtual void handleCollision(Collision collision);
+
+    /**
+     * @brief Gestisce l'urto contro una cella solida della griglia di tile
+     *
+     * Implementazione di base: come handleCollision, sposta l'attore fuori
+     * dalla cella.
+     *
+     * @param tilePos Angolo in alto a sinistra della cella
+     * @param tileSize Dimensioni della cella
+     * @param direction Da che direzione è avvenuto l'urto
+     */
+    virtual void handleTileCollision(Vec2<float> tilePos, Vec2<float> tileSize, Direction direction);
+
+  protected:
+    /** @brief Sposta l'attore a filo del rettangolo urtato, dal lato indicato da direction */
+    void pushOut(Vec2<float> otherPos, Vec2<float> otherSize, Direction direction);
+  };
+
+  /**
+   * @brief Distruttore degli attori posseduti da un'Arena
+   *
+   * Gli attori creati con Arena::emplace vivono nella memoria dell'arena:
+   * il deleter ne chiama il distruttore e restituisce il blocco al pool
+   * da cui viene. Quelli creati con make_unique (resource nullo) vengono
+   * cancellati normalmente con delete.
+   */
+  struct ActorDeleter
+  {
+    std::pmr::memory_resource* resource{nullptr}; // nullptr = allocato sull'heap globale
+    std::size_t bytes{0};                         // sizeof del tipo concreto
+    std::size_t alignment{0};                     // alignof del tipo concreto
+
+    ActorDeleter() = default;
+    ActorDeleter(std::pmr::memory_resource* resource, const std::size_t bytes, const std::size_t alignment)
+      : resource(resource), bytes(bytes), alignment(alignment)
+    {
+    }
+
+    // Permette di passare un std::unique_ptr<T> dove serve un ActorPtr
+    template <typename T>
+    ActorDeleter(std::default_delete<T>)
+    {
+    }
+
+    void operator()(Actor* actor) const;
   };
+
+  /** @brief Proprietà di un attore, sull'heap o nella memoria di un'Arena */
+  using ActorPtr = std::unique_ptr<Actor, ActorDeleter>;
 } // namespace lulu
@@ -1,9 +1,12 @@
 #pragma once
+#include "animationTable.hpp"
+#include "spriteRegistry.hpp"
 #include "types.hpp"
 #include <cstdint>
 #include <fstream>
-#include <map>
-#include <vector>
+#include <optional>
+#include <span>
+#include <string>
 
 namespace lulu
 {
@@ -11,15 +14,13 @@ namespace lulu
    * @brief Gestore delle animazioni sprite per attori mobili
    *
    * L'AnimationHandler si occupa di:
-   * - Memorizzare sequenze di sprite per diverse combinazioni stato/direzione
    * - Tenere traccia dello stato corrente, direzione e frame dell'animazione
    * - Fornire la sprite corretta da renderizzare in ogni momento
    * - Avanzare automaticamente attraverso i frame delle animazioni
    *
-   * Struttura delle animazioni:
-   * animationSet_[STATO][DIREZIONE] = [sprite1, sprite2, sprite3, ...]
-   *
-   * Esempio: animationSet_[S_MOVING][D_UP] = ["link_walk_up_1.png", "link_walk_up_2.png"]
+   * Le sequenze di frame non sono copiate nell'handler: stanno in una
+   * AnimationTable condivisa da tutte le istanze dello stesso personaggio.
+   * Lo stato per istanza è un puntatore alla tabella più pochi byte.
    */
   class AnimationHandler
   {
@@ -27,14 +28,13 @@ namespace lulu
     // === STATO CORRENTE DELL'ANIMAZIONE ===
 
     Direction movementDirection_; // Direzione corrente (determina quale animazione usare)
-    std::uint8_t frame_; // Frame corrente nella sequenza (0, 1, 2, ...)
+    std::uint16_t frame_; // Frame corrente nella sequenza (0, 1, 2, ...)
     State state_; // Stato corrente (determina quale set di animazioni usare)
 
-    // === STORAGE DELLE ANIMAZIONI ===
+    // === ANIMAZIONI ===
 
-    // Mappa tridimensionale: Stato -> Direzione -> Sequenza di sprite
-    // Ogni combinazione stato/direzione ha la sua sequenza di immagini
-    std::map<State, std::map<Direction, std::vector<std::string>>> animationSet_;
+    // Tabella condivisa [Stato][Direzione] -> clip (non posseduta)
+    const AnimationTable* table_{nullptr};
 
     // === HELPER INTERNI ===
 
@@ -84,7 +84,7 @@ namespace lulu
     [[nodiscard]] Direction currentDirection() const;
 
     /** @brief Restituisce il frame corrente nella sequenza (0-based) */
-    [[nodiscard]] std::uint8_t currentFrame() const;
+    [[nodiscard]] std::uint16_t currentFrame() const;
 
     /** @brief Restituisce lo stato corrente dell'animazione */
     [[nodiscard]] State currentState() const;
@@ -92,20 +92,21 @@ namespace lulu
     // === CONTROLLO ANIMAZIONI ===
 
     /**
-     * @brief Restituisce la sequenza di sprite per lo stato/direzione correnti
+     * @brief Restituisce la sequenza di frame per lo stato/direzione correnti
      *
-     * @return Riferimento al vector di percorsi sprite
+     * @return Vista sui frame della clip corrente (vuota se non c'è animazione)
      */
-    [[nodiscard]] const std::vector<std::string>& currentAnimation() const;
+    [[nodiscard]] std::span<const AnimationFrame> currentAnimation() const;
 
     /**
-     * @brief Aggiunge una nuova sequenza di animazione
+     * @brief Collega l'handler a una tabella di animazioni compilata
+     *
+     * La tabella non viene copiata e deve sopravvivere all'handler
+     * (tipicamente è posseduta dal CharacterConfig del personaggio).
      *
-     * @param state Stato per cui vale questa animazione (S_MOVING, S_ATTACK, ecc.)
-     * @param direction Direzione per cui vale (D_UP, D_LEFT, ecc.)
-     * @param animation Sequenza di percorsi delle sprite
+     * @param table Tabella condivisa, oppure nullptr per nessuna animazione
      */
-    void addAnimation(State state, Direction direction, const std::vector<std::string>& animation);
+    void setTable(const AnimationTable* table);
 
     /**
      * @brief Cambia stato e direzione, resettando il frame a 0
@@ -127,9 +128,18 @@ namespace lulu
      * 2. Incrementa il contatore frame
      * 3. Se raggiunge la fine, ricomincia da 0 (loop)
      *
-     * @return Percorso della sprite da renderizzare (vuoto se nessuna animazione)
+     * @return Sprite da renderizzare (NO_SPRITE se nessuna animazione)
      */
-    std::string nextSprite();
+    SpriteId nextSprite();
+
+    /**
+     * @brief Come nextSprite(), ma restituisce anche le dimensioni del frame
+     *
+     * Le dimensioni sono quelle risolte al caricamento: nessun accesso al disco.
+     *
+     * @return Frame corrente (NO_SPRITE e dimensioni nulle se nessuna animazione)
+     */
+    const AnimationFrame& nextFrame();
 
     // === METODI DI UTILITÀ ===
 
@@ -137,12 +147,19 @@ namespace lulu
      * @brief Determina le dimensioni di un file PNG
      *
      * Legge l'header del file PNG per estrarre larghezza e altezza.
-     * Utile per determinare automaticamente le dimensioni degli attori
-     * basandosi sulle loro sprite.
+     * Fa I/O su disco: va usato solo al caricamento delle animazioni
+     * (vedi CharacterConfig), mai durante il tick.
      *
      * @param filepath Percorso del file PNG da analizzare
      * @return Dimensioni del PNG, oppure nullopt se errore
      */
     static std::optional<Vec2<float>> getSpriteDimension(const std::string& filepath);
+
+    /**
+     * @brief Numero di PNG aperti finora da getSpriteDimension (in tutto il processo)
+     *
+     * Strumentazione: dopo il caricamento deve restare fermo (vedi tests/). Thread-safe.
+     */
+    static std::size_t readCount();
   };
 } // namespace lulu
@@ -0,0 +1,73 @@
+#pragma once
+#include "spriteRegistry.hpp"
+#include "types.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Un frame di animazione: sprite e sue dimensioni
+   *
+   * Le dimensioni vengono lette dall'header PNG una volta sola, quando
+   * l'animazione viene caricata: durante il gioco non si tocca il disco.
+   */
+  struct AnimationFrame
+  {
+    SpriteId sprite;    // Immagine, internata in SpriteRegistry
+    Vec2<float> size{}; // Dimensioni dell'immagine in pixel
+  };
+
+  /**
+   * @brief Tabella di animazioni compilata e condivisa da tutte le istanze di un personaggio
+   *
+   * Tutti i frame stanno in un unico array contiguo; per ogni coppia
+   * [State][Direction] la tabella memorizza solo un intervallo (primo
+   * frame, numero di frame). Sequenze identiche (es: le tre direzioni
+   * "verso l'alto" che usano la stessa animazione) vengono memorizzate una
+   * volta sola e condivise.
+   *
+   * Una volta costruita la tabella è immutabile: vive nel CharacterConfig e
+   * gli AnimationHandler ne tengono solo un puntatore.
+   */
+  class AnimationTable final
+  {
+    // Intervallo di frame di una clip dentro frames_
+    struct Clip
+    {
+      std::uint16_t first{0};
+      std::uint16_t count{0};
+    };
+
+    std::vector<AnimationFrame> frames_;
+    std::array<std::array<Clip, DIRECTION_COUNT>, STATE_COUNT> clips_{};
+
+  public:
+    /**
+     * @brief Registra la sequenza di frame per una coppia stato/direzione
+     *
+     * Se la stessa sequenza è già presente viene riusata senza copiarla.
+     *
+     * @param state Stato dell'animazione
+     * @param direction Direzione dell'animazione
+     * @param frames Sequenza di frame (vuota = nessuna animazione)
+     * @throws std::length_error se la tabella supererebbe 65535 frame
+     */
+    void set(State state, Direction direction, std::span<const AnimationFrame> frames);
+
+    /**
+     * @brief Restituisce la clip di una coppia stato/direzione
+     *
+     * @return Vista sui frame della clip (vuota se non registrata)
+     */
+    [[nodiscard]] std::span<const AnimationFrame> clip(State state, Direction direction) const;
+
+    /** @brief Vero se la sprite compare in almeno un frame della tabella */
+    [[nodiscard]] bool contains(SpriteId sprite) const;
+
+    /** @brief Numero totale di frame memorizzati (dopo la deduplicazione) */
+    [[nodiscard]] std::size_t frameCount() const;
+  };
+} // namespace lulu
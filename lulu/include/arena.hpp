@@ -1,47 +1,311 @@
 #pragma once
+#include "aabbBatch.hpp"
+#include "actor.hpp"
+#include "rng.hpp"
+#include "roomData.hpp"
+#include "slotMap.hpp"
+#include "spatialGrid.hpp"
+#include "staticIndex.hpp"
+#include "tileMap.hpp"
+#include "transformStore.hpp"
 #include "types.hpp"
+#include <array>
+#include <concepts>
 #include <memory>
-#include <unordered_map>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <vector>
-#include <nlohmann/json.hpp>
 
 namespace lulu
 {
-  class Actor;
-
   class Arena final
   {
     Vec2<float> pos_{};
     Vec2<float> size_{};
-    std::vector<Key> prevInputs_, currInputs_;
-    std::vector<std::unique_ptr<Actor>> actors_;
-    std::unordered_map<const Actor*, std::vector<Collision>> collisions_;
+    // Tasti premuti al tick precedente e a quello corrente, più i fronti
+    // calcolati una volta sola per tick
+    KeyMask prevInputs_{0}, currInputs_{0};
+    KeyMask pressed_{0}, released_{0};
+    // Memoria della stanza: gli attori creati con emplace() vengono presi da
+    // pool per dimensione, appoggiati a blocchi grandi chiesti all'allocatore
+    // globale. Un attore distrutto restituisce il blocco al pool; l'arena
+    // libera tutto in una volta quando viene distrutta. Dichiarati prima degli
+    // attori, così vengono distrutti dopo di loro.
+    std::pmr::monotonic_buffer_resource memory_{INITIAL_MEMORY};
+    std::pmr::unsynchronized_pool_resource pool_{&memory_};
+
+    // Proprietà degli attori: array denso in ordine di spawn, indirizzabile per ActorHandle
+    SlotMap<ActorPtr> actors_;
+
+    // Posizioni, dimensioni e velocità degli attori, in array paralleli ad actors_.items()
+    TransformStore transforms_;
+
+    // Collisioni dell'ultimo tick, indicizzate per slot (ActorHandle::index)
+    std::vector<std::vector<Collision>> collisions_;
+
+    // Attori raggruppati per bit di ActorKind, in ordine di spawn
+    std::array<std::vector<Actor*>, ACTOR_KIND_COUNT> kinds_;
+
+    // Broadphase: solo gli attori che condividono una cella vengono testati.
+    // Gli attori statici (muri, porte, NPC) stanno in un indice cotto una volta
+    // sola, i Movable in una griglia aggiornata a ogni movimento. Entrambi
+    // leggono i rettangoli da transforms_, non dagli attori.
+    SpatialGrid grid_;
+    StaticIndex staticIndex_;
+    std::vector<SpatialGrid::Entry> statics_; // In ordine di spawn
+    AabbBatch staticBoxes_;
+    bool staticIndexDirty_{false};
+    std::uint64_t nextSpawnOrder_{0};
+    std::vector<SpatialGrid::Entry> candidates_, staticCandidates_, dynamicCandidates_;
+
+    // Muri della stanza come griglia di tile: un Movable controlla solo le celle che tocca
+    TileMap tiles_;
+
+  public:
+    /** @brief Rettangolo dell'arena in cui il contenuto statico è cambiato */
+    struct Region
+    {
+      Vec2<float> pos{};
+      Vec2<float> size{};
+    };
+
+  private:
+    // Cambi del contenuto statico (attori statici, tile) non ancora raccolti dal renderer
+    std::vector<Region> dirtyRegions_;
+
+    // Geometrie dei candidati impacchettate per il test in blocco (overlapBatch)
+    AabbBatch candidateBoxes_;
+    std::vector<Direction> candidateDirections_;
+    std::vector<std::uint64_t> candidateHits_;
 
+    // Spawn e rimozioni chiesti durante il tick vengono applicati alla fine,
+    // così le liste su cui il tick sta iterando non cambiano sotto i piedi
+    bool ticking_{false};
+    std::vector<ActorPtr> pendingSpawns_;
+    std::vector<Actor*> pendingKills_;
+
+    // Casualità riproducibile: ogni attore che ne ha bisogno riceve un seme da qui
+    std::uint64_t seed_{DEFAULT_SEED};
+    Rng rng_{DEFAULT_SEED};
+
+    void bakeStaticIndex();
+    void insert(ActorPtr actor);
+    void leaveBroadphase(const Actor* actor);
+    void flushPending();
+    void removePendingKills();
     void detectCollisionsFor(const Actor* actor);
     void handleCollisionsFor(Actor* actor) const;
+    void resolveTilesFor(Actor* actor) const;
 
     // Helper per parsing JSON
-    void loadActors(const nlohmann::json& arenaJson);
-    void loadEnemies(const nlohmann::json& arenaJson);
-    void loadDoors(const nlohmann::json& arenaJson);
-    void loadNPCs(const nlohmann::json& arenaJson);
+    void loadActors(const RoomData& room);
+    void loadEnemies(const RoomData& room);
+    void loadDoors(const RoomData& room);
+    void loadNPCs(const RoomData& room);
 
   public:
-    Arena(Vec2<float> pos, Vec2<float> size);
-    explicit Arena(const std::string& configPath);
+    /** @brief Seme usato se né la stanza né il chiamante ne indicano uno */
+    static constexpr std::uint64_t DEFAULT_SEED = 0x4c754c75;
+
+    /** @brief Primo blocco di memoria della stanza (i successivi crescono geometricamente) */
+    static constexpr std::size_t INITIAL_MEMORY = 16 * 1024;
+
+    Arena(Vec2<float> pos, Vec2<float> size, std::uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Carica una stanza da file (JSON o compilato, vedi RoomData::load)
+     *
+     * @param configPath Percorso del file della stanza
+     * @param seed Seme della stanza; se assente si usa il campo "seed"
+     *             del JSON, altrimenti DEFAULT_SEED
+     */
+    explicit Arena(const std::string& configPath, std::optional<std::uint64_t> seed = std::nullopt);
+
+    /**
+     * @brief Costruisce una stanza già caricata (vedi RoomData::load)
+     *
+     * @param room Contenuto della stanza
+     * @param seed Seme della stanza; se assente si usa quello di room, altrimenti DEFAULT_SEED
+     */
+    explicit Arena(const RoomData& room, std::optional<std::uint64_t> seed = std::nullopt);
+
+    // Gli attori puntano alla loro arena: spostarla li lascerebbe appesi
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
 
     [[nodiscard]] const Vec2<float>& pos() const;
     [[nodiscard]] const Vec2<float>& size() const;
-    [[nodiscard]] const std::vector<Key>& prevInputs() const;
-    [[nodiscard]] const std::vector<Key>& currInputs() const;
-    [[nodiscard]] const std::vector<std::unique_ptr<Actor>>& actors() const;
-    [[nodiscard]] const std::unordered_map<const Actor*, std::vector<Collision>>& collisions() const;
+    [[nodiscard]] KeyMask prevInputs() const;
+    [[nodiscard]] KeyMask currInputs() const;
+    /** @brief Griglia di tile della stanza (vuota se la stanza non ne ha) */
+    [[nodiscard]] const TileMap& tiles() const;
+
+    /**
+     * @brief Cambia il tipo di una cella della griglia (es: una porta nel muro che si apre)
+     *
+     * Collisioni e disegno seguono dal tick successivo; la cella viene
+     * segnalata come da ridisegnare.
+     *
+     * @throws std::out_of_range come TileMap::set
+     */
+    void setTile(int column, int row, std::uint16_t type);
+
+    /**
+     * @brief Segnala che il contenuto statico in un rettangolo è cambiato
+     *
+     * Il renderer compone una volta sola sfondo, tile e attori statici: qui
+     * gli si dice quale parte ridisegnare. Spawn e rimozioni di attori
+     * statici, setTile e Actor::setSprite lo chiamano da soli.
+     */
+    void invalidate(Vec2<float> pos, Vec2<float> size);
+
+    /** @brief Rettangoli cambiati dall'ultima clearDirtyRegions() */
+    [[nodiscard]] std::span<const Region> dirtyRegions() const;
 
-    void spawn(std::unique_ptr<Actor> actor);
+    /** @brief Da chiamare dopo aver ridisegnato i rettangoli cambiati */
+    void clearDirtyRegions();
+
+    /** @brief Tutti gli attori, in ordine di spawn (ordine di rendering) */
+    [[nodiscard]] std::span<const ActorPtr> actors() const;
+
+    /**
+     * @brief Geometria di tutti gli attori in SoA, parallela ad actors()
+     *
+     * L'elemento i è actors()[i]: chi deve scorrere posizioni e dimensioni
+     * (es: il renderer) può leggerle da qui senza toccare gli attori.
+     */
+    [[nodiscard]] const TransformStore& transforms() const;
+
+    /**
+     * @brief Collisioni rilevate per un Movable nell'ultimo tick
+     *
+     * @return Vuoto se l'handle è scaduto o l'attore è statico
+     */
+    [[nodiscard]] std::span<const Collision> collisions(ActorHandle handle) const;
+
+    /** @brief Restituisce l'attore di un handle, oppure nullptr se è stato rimosso */
+    [[nodiscard]] Actor* get(ActorHandle handle) const;
+
+    /** @brief Come get(), ma solo se l'attore è di tipo T (vedi Actor::as) */
+    template <typename T>
+    [[nodiscard]] T* get(const ActorHandle handle) const
+    {
+      Actor* actor = get(handle);
+      return actor ? actor->as<T>() : nullptr;
+    }
+
+    /** @brief Seme con cui è stata creata l'arena */
+    [[nodiscard]] std::uint64_t seed() const;
+
+    /** @brief Generatore dell'arena, da cui derivare i semi degli attori spawnati */
+    [[nodiscard]] Rng& rng();
+
+    /**
+     * @brief Hash dello stato simulato: tipo, posizione e HP di ogni attore
+     *
+     * Due simulazioni con lo stesso hash a ogni tick sono (con altissima
+     * probabilità) identiche: usato dal replay per rilevare divergenze.
+     */
+    [[nodiscard]] std::uint64_t stateHash() const;
+
+    // === QUERY TIPIZZATE ===
+
+    /** @brief Attori di una categoria (un singolo bit di ActorKind), in ordine di spawn */
+    [[nodiscard]] const std::vector<Actor*>& actorsOf(ActorKind kind) const;
+
+    /** @brief Primo attore di tipo T (T::KIND come in Actor::as), oppure nullptr */
+    template <typename T>
+    [[nodiscard]] T* first() const
+    {
+      static_assert(std::has_single_bit(static_cast<unsigned>(T::KIND)), "T::KIND must be a single ActorKind bit");
+      const auto& matching = actorsOf(T::KIND);
+      return matching.empty() ? nullptr : static_cast<T*>(matching.front());
+    }
+
+    /** @brief Chiama f(T&) su ogni attore di tipo T */
+    template <typename T, typename F>
+    void forEach(F&& f) const
+    {
+      static_assert(std::has_single_bit(static_cast<unsigned>(T::KIND)), "T::KIND must be a single ActorKind bit");
+      for (Actor* actor : actorsOf(T::KIND))
+        f(*static_cast<T*>(actor));
+    }
+
+    /**
+     * @brief Aggiunge un attore all'arena
+     *
+     * Durante il tick l'inserimento viene rimandato alla fine del tick:
+     * il nuovo attore si muove a partire dal tick successivo.
+     */
+    void spawn(ActorPtr actor);
+
+    /**
+     * @brief Aggiunge un attore all'arena in una posizione data (es: Link che entra da una porta)
+     *
+     * Un attore fuori da un'arena non ha una geometria leggibile o
+     * modificabile: la posizione d'ingresso si passa qui.
+     */
+    void spawn(ActorPtr actor, Vec2<float> pos);
+
+    /**
+     * @brief Costruisce un attore nella memoria dell'arena e lo aggiunge (come spawn)
+     *
+     * Niente allocazione per attore sull'heap globale: il blocco viene da un
+     * pool dell'arena. Un attore creato così non può sopravvivere all'arena,
+     * quindi non può essere estratto con kill(); per gli attori che cambiano
+     * stanza (Link) usare spawn(std::make_unique<T>(...)).
+     *
+     * @return L'attore appena creato (valido finché non viene rimosso)
+     */
+    template <std::derived_from<Actor> T, typename... Args>
+    T* emplace(Args&&... args)
+    {
+      void* block = pool_.allocate(sizeof(T), alignof(T));
+      T* actor;
+      try
+      {
+        actor = ::new(block) T(std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        pool_.deallocate(block, sizeof(T), alignof(T));
+        throw;
+      }
+      spawn(ActorPtr(actor, ActorDeleter(&pool_, sizeof(T), alignof(T))));
+      return actor;
+    }
+
+    /**
+     * @brief Rimuove e distrugge un attore, in modo differito
+     *
+     * L'attore smette subito di muoversi e di collidere, ma resta in vita
+     * (i puntatori restano validi) fino alla fine del tick corrente; se
+     * chiamato fuori dal tick, fino alla fine del prossimo. Le rimozioni
+     * vengono applicate in blocco con una sola passata per lista, quindi
+     * anche centinaia di morti nello stesso tick costano O(n).
+     */
+    void despawn(Actor* actor);
+
+    /**
+     * @brief Estrae subito un attore dall'arena e ne restituisce la proprietà
+     *
+     * Serve a trasferire un attore in un'altra arena (es: Link che cambia stanza).
+     *
+     * @throws std::logic_error se chiamato durante il tick (usare despawn), o
+     *         se l'attore è stato creato con emplace() e vive nella memoria dell'arena
+     */
     std::unique_ptr<Actor> kill(Actor* actor);
-    void tick(const std::vector<Key>& keys);
 
-    static bool hasKey(const std::vector<Key>& keys, Key key);
+    void tick(KeyMask keys);
+
+    /** @brief Il tasto è premuto in questo tick */
+    [[nodiscard]] bool isKeyDown(Key key) const;
+
+    /** @brief Il tasto è stato premuto in questo tick (non lo era nel precedente) */
     [[nodiscard]] bool isKeyJustPressed(Key key) const;
+
+    /** @brief Il tasto è stato rilasciato in questo tick (lo era nel precedente) */
+    [[nodiscard]] bool isKeyJustReleased(Key key) const;
   };
 }
\ No newline at end of file
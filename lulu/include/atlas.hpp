@@ -0,0 +1,95 @@
+#pragma once
+#include "spriteRegistry.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lulu
+{
+  /** @brief Posizione di una sprite dentro l'atlante */
+  struct AtlasRegion
+  {
+    std::uint32_t page{0}; // Indice della pagina (texture)
+    Vec2<float> pos{};     // Angolo in alto a sinistra nella pagina, in pixel
+    Vec2<float> size{};    // Dimensioni della sprite in pixel
+  };
+
+  /**
+   * @brief Atlante delle sprite: i frame di tutti i personaggi in poche pagine
+   *
+   * Invece di una texture per frame (link attack up 3.png, ...) le sprite
+   * vengono impacchettate in poche immagini grandi ("pagine") più una
+   * tabella con la regione di ogni sprite. Il renderer disegna ogni attore
+   * come un rettangolo della pagina (DrawTextureRec): finché le sprite
+   * stanno sulla stessa pagina non c'è nessun cambio di texture e raylib
+   * unisce tutto in un'unica draw call.
+   *
+   * Le pagine si generano una volta sola, in fase di build, con lulu_atlas;
+   * qui c'è solo la parte che non tocca i pixel (impacchettamento e tabella).
+   */
+  class Atlas final
+  {
+  public:
+    struct Page
+    {
+      std::string image; // Percorso del PNG della pagina
+      Vec2<float> size{};
+    };
+
+    struct Entry
+    {
+      std::string sprite; // Percorso del PNG sorgente (come in SpriteRegistry)
+      AtlasRegion region;
+    };
+
+    /** @brief Estensione della tabella dell'atlante */
+    static constexpr const char* EXTENSION = ".latlas";
+
+  private:
+    std::vector<Page> pages_;
+    std::vector<Entry> entries_;
+    std::vector<std::optional<AtlasRegion>> regions_; // Indicizzato per SpriteId
+
+    void index();
+
+  public:
+    /**
+     * @brief Impacchetta le sprite in pagine (shelf packing, sprite ordinate per altezza)
+     *
+     * Le dimensioni vengono lette dagli header PNG: le sprite non leggibili
+     * vengono saltate (vedi entries() per quelle incluse). Le sprite ripetute
+     * vengono impacchettate una volta sola; ogni pagina viene tagliata
+     * all'area usata.
+     *
+     * @param sprites Percorsi dei PNG
+     * @param pagePrefix Prefisso dei PNG delle pagine (es: "assets/atlas/page " -> "assets/atlas/page 0.png")
+     * @param pageSize Lato massimo di una pagina in pixel
+     * @param padding Pixel vuoti tra due sprite (evitano che il filtraggio "sbordi")
+     * @throws std::runtime_error se una sprite non entra in una pagina
+     */
+    static Atlas pack(std::vector<std::string> sprites, const std::string& pagePrefix,
+                      int pageSize = 1024, int padding = 1);
+
+    /**
+     * @brief Legge la tabella di un atlante
+     *
+     * Le sprite il cui PNG è più recente della tabella vengono escluse:
+     * finché l'atlante non viene rigenerato il renderer le carica dal file.
+     *
+     * @throws std::runtime_error se il file manca o non è valido
+     */
+    static Atlas load(const std::string& path);
+
+    /** @brief Scrive la tabella dell'atlante */
+    void writeBinary(const std::string& path) const;
+
+    /** @return Regione della sprite, oppure nullptr se non è nell'atlante */
+    [[nodiscard]] const AtlasRegion* region(SpriteId sprite) const;
+
+    [[nodiscard]] std::span<const Page> pages() const;
+    [[nodiscard]] std::span<const Entry> entries() const;
+  };
+} // namespace lulu
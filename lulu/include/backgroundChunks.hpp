@@ -0,0 +1,73 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace lulu
+{
+  /**
+   * @brief Tabella di uno sfondo diviso in chunk quadrati (generata da lulu_chunks)
+   *
+   * Uno sfondo grande (es: una mappa dell'overworld) non viene mai caricato
+   * come texture unica: lulu_chunks lo taglia in PNG da chunkSize pixel di
+   * lato, in una cartella accanto all'immagine, e scrive questa tabella
+   * (".lchunks"). Il gioco tiene sulla GPU solo i chunk vicini alla camera.
+   *
+   * I chunk sul bordo destro e inferiore possono essere più piccoli.
+   */
+  struct BackgroundChunks
+  {
+    /** @brief Intervallo di chunk (estremi inclusi) */
+    struct Range
+    {
+      int firstColumn{0}, firstRow{0};
+      int lastColumn{-1}, lastRow{-1}; // Vuoto se last < first
+
+      [[nodiscard]] bool empty() const { return lastColumn < firstColumn || lastRow < firstRow; }
+    };
+
+    Vec2<float> size{};     // Dimensioni dell'immagine intera in pixel
+    std::uint32_t chunkSize{256};
+    std::string directory;  // Cartella dei PNG "colonna_riga.png"
+
+    /** @brief Estensione delle tabelle dei chunk */
+    static constexpr const char* EXTENSION = ".lchunks";
+
+    /**
+     * @brief Cerca la tabella dei chunk di uno sfondo
+     *
+     * Come per gli asset compilati, la tabella vale solo se non è più
+     * vecchia dell'immagine (che può anche non esserci).
+     *
+     * @param background Percorso dello sfondo come scritto nella stanza
+     * @return La tabella, oppure nullopt se lo sfondo va caricato come texture unica
+     * @throws std::runtime_error se la tabella esiste ma non è valida
+     */
+    static std::optional<BackgroundChunks> find(const std::string& background);
+
+    /** @throws std::runtime_error se il file manca o non è valido */
+    static BackgroundChunks load(const std::string& path);
+
+    void writeBinary(const std::string& path) const;
+
+    [[nodiscard]] int columns() const;
+    [[nodiscard]] int rows() const;
+
+    /** @brief Indice denso di un chunk (riga per riga) */
+    [[nodiscard]] std::size_t index(int column, int row) const;
+
+    /** @brief Percorso del PNG di un chunk */
+    [[nodiscard]] std::string path(int column, int row) const;
+
+    /** @brief Angolo in alto a sinistra di un chunk in pixel */
+    [[nodiscard]] Vec2<float> origin(int column, int row) const;
+
+    /**
+     * @brief Chunk che intersecano un rettangolo, allargato di margin chunk per lato
+     *
+     * @return Intervallo già limitato ai chunk esistenti
+     */
+    [[nodiscard]] Range range(const Vec2<float>& pos, const Vec2<float>& rectSize, int margin = 0) const;
+  };
+} // namespace lulu
@@ -0,0 +1,141 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Scrittura di file binari little-endian (asset compilati)
+   *
+   * Accumula tutto in memoria e scrive il file con una sola chiamata in save().
+   */
+  class BinaryWriter final
+  {
+    std::vector<char> bytes_;
+
+  public:
+    template <typename T>
+      requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+    void put(const T value)
+    {
+      if constexpr (std::is_same_v<T, float>)
+      {
+        put(std::bit_cast<std::uint32_t>(value));
+      }
+      else if constexpr (std::is_same_v<T, bool> || std::is_enum_v<T>)
+      {
+        put(static_cast<std::uint32_t>(value));
+      }
+      else
+      {
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+          bytes_.push_back(static_cast<char>(value >> (8 * i) & 0xff));
+      }
+    }
+
+    /** @brief Stringa come u32 lunghezza + byte */
+    void put(const std::string& value);
+
+    /** @brief Byte grezzi, senza lunghezza (es: magic number) */
+    void putRaw(std::span<const char> bytes);
+
+    /** @throws std::runtime_error se il file non può essere scritto */
+    void save(const std::string& path) const;
+  };
+
+  /**
+   * @brief Lettura di file binari little-endian (asset compilati)
+   *
+   * Il file viene letto per intero con una sola read; poi i valori vengono
+   * estratti dal buffer in memoria, senza altre chiamate al sistema operativo.
+   * Ogni lettura oltre la fine del file lancia std::runtime_error.
+   */
+  class BinaryReader final
+  {
+    std::vector<char> bytes_;
+    std::size_t offset_{0};
+    std::string path_; // Per i messaggi d'errore
+
+    const char* take(std::size_t count);
+
+  public:
+    /** @throws std::runtime_error se il file non può essere aperto */
+    explicit BinaryReader(const std::string& path);
+
+    template <typename T>
+      requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+    T get()
+    {
+      if constexpr (std::is_same_v<T, float>)
+      {
+        return std::bit_cast<float>(get<std::uint32_t>());
+      }
+      else if constexpr (std::is_same_v<T, bool>)
+      {
+        return get<std::uint32_t>() != 0;
+      }
+      else if constexpr (std::is_enum_v<T>)
+      {
+        return static_cast<T>(get<std::uint32_t>());
+      }
+      else
+      {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(take(sizeof(T)));
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+          value |= static_cast<T>(bytes[i]) << (8 * i);
+        return value;
+      }
+    }
+
+    std::string getString();
+
+    /**
+     * @brief Legge un numero di elementi (u32) che devono ancora stare nel file
+     *
+     * Da usare prima di ridimensionare un vector con un conteggio letto dal
+     * file: un file corrotto non può far allocare più di quanto è grande.
+     *
+     * @param elementSize Byte occupati nel file da ciascun elemento (almeno)
+     * @throws std::runtime_error se gli elementi non entrano nei byte rimasti
+     */
+    std::size_t getCount(std::size_t elementSize);
+
+    /** @brief Byte non ancora letti */
+    [[nodiscard]] std::size_t remaining() const;
+
+    /**
+     * @brief Controlla magic number e versione all'inizio del file
+     *
+     * @throws std::runtime_error se non corrispondono
+     */
+    void expectHeader(std::span<const char> magic, std::uint32_t version);
+
+    /** @brief Lancia std::runtime_error se restano byte non letti */
+    void expectEnd() const;
+  };
+
+  /**
+   * @brief Percorso della versione compilata di un asset JSON (stesso nome, altra estensione)
+   *
+   * Es: "assets/dungeon/rooms/hall.json" -> "assets/dungeon/rooms/hall.lroom"
+   */
+  std::string compiledPath(const std::string& sourcePath, std::string_view extension);
+
+  /**
+   * @brief Versione compilata da usare al posto del JSON, se esiste ed è aggiornata
+   *
+   * Durante lo sviluppo basta modificare il JSON: finché non viene
+   * ricompilato, il file binario (più vecchio) viene ignorato.
+   *
+   * @return Percorso del file compilato, oppure nullopt se si deve leggere il JSON
+   */
+  std::optional<std::string> freshCompiled(const std::string& sourcePath, std::string_view extension);
+} // namespace lulu
@@ -0,0 +1,72 @@
+#pragma once
+#include "animationTable.hpp"
+#include "types.hpp"
+#include <memory>
+#include <string>
+
+namespace lulu
+{
+  /**
+   * @brief Descrittore immutabile di un personaggio (link.json, zol.json, ...)
+   *
+   * Raccoglie in forma tipizzata le sezioni "actor", "movable", "fighter" e
+   * "animations" del file di configurazione. Ogni file viene letto e
+   * parsato una volta sola per processo: load() restituisce sempre la
+   * stessa istanza condivisa, quindi spawnare decine di nemici dello
+   * stesso tipo non tocca più il disco. Anche le dimensioni di ogni frame
+   * vengono lette dai PNG qui, una volta sola.
+   */
+  struct CharacterConfig
+  {
+    // === SEZIONE "actor" ===
+    SpriteId sprite{NO_SPRITE}; // Sprite iniziale
+    Vec2<float> size{};         // Dimensioni del rettangolo di collisione
+
+    // === SEZIONE "movable" ===
+    Vec2<float> speed{};  // Velocità in pixel per frame
+    bool enableAnimation{false};
+
+    // === SEZIONE "fighter" ===
+    float hp{0.0f};
+    float damage{0.0f};
+
+    // === SEZIONE "animations" ===
+    // "movement" vale per S_MOVING e S_STILL, "attack" per S_ATTACK;
+    // le diagonali usano la clip verticale (es: D_UPLEFT usa up)
+    AnimationTable animations;
+
+    /** @brief Estensione dei descrittori compilati (vedi lulu_compile) */
+    static constexpr const char* COMPILED_EXTENSION = ".lchar";
+
+    /**
+     * @brief Restituisce il descrittore del file, leggendolo solo al primo accesso
+     *
+     * Se accanto al JSON c'è la versione compilata (".lchar") ed è
+     * aggiornata, viene letta quella: niente parsing e niente PNG da aprire
+     * per le dimensioni dei frame, che sono già nel binario.
+     *
+     * Thread-safe: la cache è protetta da un mutex.
+     *
+     * @param configPath Percorso del file di configurazione JSON
+     * @return Descrittore condiviso e immutabile
+     * @throws std::runtime_error se il file non esiste
+     */
+    static std::shared_ptr<const CharacterConfig> load(const std::string& configPath);
+
+    /** @brief Legge sempre il JSON, senza cache (usato dal compilatore) */
+    static CharacterConfig parseJson(const std::string& configPath);
+
+    /** @brief Legge un descrittore compilato, senza cache */
+    static CharacterConfig readBinary(const std::string& path);
+
+    /** @brief Scrive il descrittore nel formato compilato */
+    void writeBinary(const std::string& path) const;
+
+    /**
+     * @brief Numero di file di personaggio letti finora dal processo (JSON o binari)
+     *
+     * Strumentazione, come RoomData::loadCount(). Thread-safe.
+     */
+    static std::size_t loadCount();
+  };
+} // namespace lulu
@@ -1,7 +1,9 @@
 #pragma once
 #include "actor.hpp"
+#include "characterConfig.hpp"
 #include "movable.hpp"
 #include "types.hpp"
+#include <memory>
 
 namespace lulu
 {
@@ -24,6 +26,9 @@ namespace lulu
     float hp_;     // Punti vita correnti
     float damage_; // Danno inflitto per attacco
 
+    // Descrittore condiviso da cui è stato creato (nullptr se costruito con parametri espliciti)
+    std::shared_ptr<const CharacterConfig> config_;
+
     // === SISTEMA DI ATTACCO (DA IMPLEMENTARE NELLE SOTTOCLASSI) ===
     void recoil(Direction collisionDirection);
 
@@ -43,17 +48,23 @@ namespace lulu
             const std::string &sprite = "");
 
     /**
-     * @brief Costruttore che carica da file JSON
+     * @brief Costruttore da descrittore condiviso
      *
-     * Il file deve contenere sezioni per "actor", "movable" e "fighter"
-     * con tutti i parametri necessari.
+     * Usa le sezioni "actor", "movable" e "fighter" del descrittore.
+     * Il descrittore non viene copiato: tutte le istanze dello stesso
+     * personaggio condividono lo stesso oggetto.
      *
      * @param pos Posizione iniziale
-     * @param configPath Percorso del file di configurazione JSON
+     * @param config Descrittore del personaggio (vedi CharacterConfig::load)
      */
-    explicit Fighter(Vec2<float> pos, const std::string &configPath);
+    Fighter(Vec2<float> pos, std::shared_ptr<const CharacterConfig> config);
 
   public:
+    static constexpr ActorKind KIND = AK_FIGHTER;
+
+    /** @brief Un Fighter è sempre anche Movable */
+    [[nodiscard]] Movable* asMovable() override;
+
     // === GETTERS ===
 
     /**
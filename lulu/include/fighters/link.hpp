@@ -103,6 +103,9 @@ namespace lulu
      */
     void handleCollision(Collision collision) override;
 
+    /** @brief Come per gli ostacoli statici: durante l'attacco le celle solide vengono attraversate */
+    void handleTileCollision(Vec2<float> tilePos, Vec2<float> tileSize, Direction direction) override;
+
     /**
      * @brief Aggiusta la posizione in base al cambio di dimensioni
      *
@@ -115,10 +118,12 @@ namespace lulu
     void adjustPositionForSize(const Vec2<float>& sizeDifference);
 
   public:
+    static constexpr ActorKind KIND = AK_PLAYER;
+
     /**
-     * @brief Costruttore: carica configurazione da JSON
+     * @brief Costruttore da descrittore già caricato
      *
-     * Il file link.json contiene:
+     * Il descrittore (tipicamente da link.json) contiene:
      * - Statistiche base (HP, danno, velocità, dimensioni)
      * - Set completo di animazioni per tutti gli stati e direzioni:
      *   * Movimento: 8 direzioni con sequenze di sprite
@@ -126,7 +131,15 @@ namespace lulu
      *   * Attacco: 4 direzioni cardinali con sequenze
      *
      * @param pos Posizione iniziale di spawn
-     * @param configPath Percorso del file JSON (default: assets/link/link.json)
+     * @param config Descrittore condiviso del personaggio
+     */
+    Link(Vec2<float> pos, std::shared_ptr<const CharacterConfig> config);
+
+    /**
+     * @brief Costruttore che passa dalla cache dei descrittori
+     *
+     * @param pos Posizione iniziale di spawn
+     * @param configPath Percorso del file JSON (default: assets/characters/link/link.json)
      */
     explicit Link(Vec2<float> pos, const std::string &configPath = "assets/characters/link/link.json");
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "fighter.hpp"
+#include "rng.hpp"
 
 namespace lulu {
 
@@ -10,12 +11,23 @@ namespace lulu {
         std::uint8_t animationCounter_{0};
         Direction currentDirection_{D_DOWN};
 
+        // Stream casuale privato: updatedDirection() è const ma estrae numeri
+        mutable Rng rng_;
+
         [[nodiscard]] State updatedState() const override;
         [[nodiscard]] Direction updatedDirection() const override;
         [[nodiscard]] Vec2<float> calculateMovement(Direction dir) const override;
 
     public:
-        explicit Zol(Vec2<float> pos, const std::string &config = "assets/characters/zol/zol.json");
+        static constexpr ActorKind KIND = AK_ZOL;
+
+        /**
+         * @param pos Posizione iniziale
+         * @param seed Seme del movimento casuale (tipicamente Arena::rng().next64())
+         * @param config Descrittore condiviso del personaggio
+         */
+        Zol(Vec2<float> pos, std::uint64_t seed, std::shared_ptr<const CharacterConfig> config);
+        Zol(Vec2<float> pos, std::uint64_t seed, const std::string &configPath = "assets/characters/zol/zol.json");
 
         void move() override;
     };
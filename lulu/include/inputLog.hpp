@@ -0,0 +1,95 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Registrazione compatta di una sessione di gioco
+   *
+   * Contiene tutto ciò che serve per rigiocare una sessione in modo
+   * deterministico: stanza iniziale, seme, posizione di spawn di Link e,
+   * per ogni tick, i tasti premuti. Gli input sono codificati a run:
+   * una coppia (KeyMask, numero di tick) per ogni cambio di tasti.
+   *
+   * Per ogni tick viene salvato anche un hash a 32 bit dello stato
+   * dell'Arena (vedi Arena::stateHash): durante il replay il primo hash
+   * diverso indica il tick esatto in cui la simulazione si è staccata
+   * dalla registrazione. Un minuto di gioco a 60 tick/s costa circa
+   * 14 KB di hash, più i run dei tasti.
+   */
+  class InputLog final
+  {
+  public:
+    /** @brief Tasti tenuti premuti per un certo numero di tick consecutivi */
+    struct Run
+    {
+      KeyMask keys;
+      std::uint32_t ticks;
+    };
+
+  private:
+    std::string room_;
+    std::uint64_t seed_{0};
+    Vec2<float> spawn_{};
+    std::vector<Run> runs_;
+    std::vector<std::uint32_t> hashes_; // Uno per tick
+    std::uint64_t ticks_{0};
+
+    /** @brief Riduce l'hash dell'Arena ai 32 bit salvati nel file */
+    static std::uint32_t fold(std::uint64_t hash);
+
+  public:
+    InputLog() = default;
+
+    /**
+     * @brief Inizia una registrazione vuota
+     *
+     * @param room Percorso della stanza iniziale
+     * @param seed Seme dell'Arena iniziale (vedi Arena::seed)
+     * @param spawn Posizione iniziale di Link
+     */
+    InputLog(std::string room, std::uint64_t seed, Vec2<float> spawn);
+
+    /**
+     * @brief Aggiunge un tick alla registrazione
+     *
+     * @param keys Tasti premuti nel tick
+     * @param hash Hash dello stato dopo il tick (Arena::stateHash)
+     */
+    void record(KeyMask keys, std::uint64_t hash);
+
+    [[nodiscard]] const std::string& room() const;
+    [[nodiscard]] std::uint64_t seed() const;
+    [[nodiscard]] const Vec2<float>& spawn() const;
+    [[nodiscard]] const std::vector<Run>& runs() const;
+
+    /** @brief Numero di tick registrati */
+    [[nodiscard]] std::size_t tickCount() const;
+
+    /**
+     * @brief Confronta lo stato di un tick del replay con la registrazione
+     *
+     * @param tick Indice del tick (da 0)
+     * @param hash Hash dello stato dopo quel tick (Arena::stateHash)
+     * @return true se il tick è stato registrato e il suo hash è uguale
+     */
+    [[nodiscard]] bool matches(std::size_t tick, std::uint64_t hash) const;
+
+    /**
+     * @brief Salva la registrazione in formato binario
+     *
+     * @throws std::runtime_error se il file non può essere scritto
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Carica una registrazione salvata con save()
+     *
+     * @throws std::runtime_error se il file non esiste o non è valido
+     */
+    static InputLog load(const std::string& path);
+  };
+} // namespace lulu
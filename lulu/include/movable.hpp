@@ -4,11 +4,12 @@
 
 namespace lulu
 {
+  struct CharacterConfig;
+
   /**
    * @brief Classe base per tutti gli oggetti che possono muoversi
    *
    * Movable aggiunge alle funzionalità di Actor:
-   * - Velocità di movimento
    * - Sistema di animazioni per rappresentare movimento, stati, direzioni
    * - Logica astratta per il movimento (da implementare nelle sottoclassi)
    *
@@ -18,31 +19,26 @@ namespace lulu
   class Movable
   {
   protected:
-    // Velocità di movimento in pixel per frame (x = orizzontale, y = verticale)
-    Vec2<float> speed_{};
-
     // Gestore delle animazioni per sprite dinamiche
     // Si occupa di cambiare le sprite in base a stato, direzione e frame
     AnimationHandler movement_;
 
     /**
-     * @brief Costruttore per oggetti mobili con velocità specifica
+     * @brief Costruttore per oggetti mobili con parametri espliciti
      *
-     * @param speed Velocità di movimento
      * @param enableAnimation Se abilitare il sistema di animazioni
      */
-    explicit Movable(Vec2<float> speed, bool enableAnimation = false);
+    explicit Movable(bool enableAnimation = false);
 
     /**
-     * @brief Costruttore che carica velocità e animazioni da file JSON
+     * @brief Costruttore che prende le animazioni da un CharacterConfig
      *
-     * Il file deve contenere una sezione "movable" con:
-     * - "speed": {x, y} velocità di movimento
-     * - "enableAnimation": booleano per abilitare animazioni
+     * Usa il campo enableAnimation della sezione "movable" del descrittore
+     * (la velocità la prende Actor)
      *
-     * @param configPath Percorso del file di configurazione JSON
+     * @param config Descrittore del personaggio
      */
-    explicit Movable(const std::string& configPath);
+    explicit Movable(const CharacterConfig& config);
 
     // === METODI VIRTUALI PURI (DA IMPLEMENTARE NELLE SOTTOCLASSI) ===
 
@@ -83,11 +79,6 @@ namespace lulu
      */
     virtual ~Movable() = default;
 
-    // === GETTERS ===
-
-    /** @brief Restituisce la velocità di movimento corrente */
-    [[nodiscard]] const Vec2<float>& speed() const;
-
     // === METODO PRINCIPALE ===
 
     /**
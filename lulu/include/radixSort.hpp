@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace lulu
+{
+  /** @brief Elemento da ordinare: chiave compatta più un valore trasportato (es: un indice) */
+  struct SortItem
+  {
+    std::uint32_t key;
+    std::uint32_t value;
+  };
+
+  /**
+   * @brief Ordina per chiave con un radix sort LSD a 4 passate da 8 bit
+   *
+   * Stabile: a parità di chiave resta l'ordine d'ingresso, quindi il
+   * risultato è deterministico. Costa O(n) invece di O(n log n); gli
+   * istogrammi delle quattro cifre si calcolano in una sola lettura e le
+   * passate in cui tutti gli elementi hanno la stessa cifra (es: un solo
+   * layer) vengono saltate. Fino a 64 elementi usa un insertion sort.
+   *
+   * @param items Elementi da ordinare (ordinati in uscita)
+   * @param scratch Buffer di lavoro, riusato tra le chiamate per non allocare
+   */
+  void radixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+} // namespace lulu
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+namespace lulu
+{
+  /**
+   * @brief Generatore pseudo-casuale deterministico (xoshiro128**)
+   *
+   * Piccolo (16 byte di stato), veloce e riproducibile: a parità di seme
+   * produce sempre la stessa sequenza, su qualsiasi piattaforma. Ogni Arena
+   * ha il suo generatore, e ogni attore che ne ha bisogno riceve un proprio
+   * stream derivato dal generatore dell'Arena: le sequenze non dipendono
+   * dall'ordine in cui gli attori estraggono i numeri.
+   */
+  class Rng final
+  {
+    std::uint32_t state_[4]{};
+
+  public:
+    /**
+     * @brief Costruisce il generatore a partire da un seme
+     *
+     * Il seme viene espanso con splitmix64, quindi anche semi "vicini"
+     * (0, 1, 2, ...) producono sequenze indipendenti.
+     *
+     * @param seed Seme del generatore
+     */
+    explicit Rng(std::uint64_t seed = 0);
+
+    /** @brief Restituisce 32 bit pseudo-casuali */
+    std::uint32_t next();
+
+    /** @brief Restituisce 64 bit pseudo-casuali (es: per derivare il seme di un altro Rng) */
+    std::uint64_t next64();
+
+    /**
+     * @brief Restituisce un intero uniforme in [0, bound)
+     *
+     * @param bound Estremo superiore escluso (deve essere > 0)
+     */
+    std::uint32_t below(std::uint32_t bound);
+  };
+} // namespace lulu
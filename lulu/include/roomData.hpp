@@ -0,0 +1,109 @@
+#pragma once
+#include "tileMap.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Risorse di una scena: sfondo, musica e tasti da ascoltare
+   *
+   * È la parte del file di stanza che serve alla scena (GameScene); il
+   * resto serve all'Arena. Le scene senza file (il menu) la costruiscono
+   * direttamente.
+   */
+  struct SceneConfig
+  {
+    std::string background; // Percorso dell'immagine di sfondo
+    std::string music;      // Percorso della musica di sottofondo
+    std::vector<Key> inputs;
+  };
+
+  /**
+   * @brief Contenuto tipizzato di un file di stanza (es: assets/dungeon/rooms/hall.json)
+   *
+   * Una stanza può arrivare dal JSON o dalla sua versione compilata
+   * (".lroom", prodotta da lulu_compile): load() usa il binario se è
+   * aggiornato, altrimenti ricade sul JSON. Il binario si legge con una
+   * sola read e senza parsing di testo.
+   *
+   * Un file di stanza va letto una volta sola per ingresso nella stanza:
+   * lo stesso RoomData costruisce sia la scena (scene) sia l'Arena.
+   */
+  struct RoomData
+  {
+    /** @brief Rettangolo statico (muri e ostacoli invisibili) */
+    struct Block
+    {
+      Vec2<float> pos{};
+      Vec2<float> size{};
+    };
+
+    struct Enemy
+    {
+      std::string type; // Es: "zol"
+      Vec2<float> pos{};
+    };
+
+    struct Door
+    {
+      Vec2<float> pos{};
+      Vec2<float> size{};
+      Vec2<float> spawn{};     // Dove compare Link nella stanza di destinazione
+      std::string destination; // Percorso del JSON della stanza di destinazione
+      bool changeMusic{false};
+    };
+
+    struct Npc
+    {
+      Vec2<float> pos{};
+      Vec2<float> size{};
+      std::string name;
+      std::string sprite;
+      std::string dialogue; // Percorso del JSON dei dialoghi
+    };
+
+    SceneConfig scene;
+
+    // === SEZIONE "arena" ===
+    Vec2<float> pos{};
+    Vec2<float> size{};
+    std::optional<std::uint64_t> seed;
+    std::vector<Block> blocks;
+    std::vector<Enemy> enemies;
+    std::vector<Door> doors;
+    std::vector<Npc> npcs;
+    TileMap tiles; // Vuota se la stanza non ha la sezione "tiles"
+
+    /** @brief Estensione dei file di stanza compilati */
+    static constexpr const char* COMPILED_EXTENSION = ".lroom";
+
+    /**
+     * @brief Carica una stanza, dal file compilato se aggiornato, altrimenti dal JSON
+     *
+     * @param path Percorso del JSON della stanza (anche se si usa il binario)
+     * @throws std::runtime_error se il file manca o non è valido
+     */
+    static RoomData load(const std::string& path);
+
+    /** @brief Legge sempre il JSON (usato dal compilatore) */
+    static RoomData parseJson(const std::string& path);
+
+    /** @brief Legge un file compilato */
+    static RoomData readBinary(const std::string& path);
+
+    /** @brief Scrive la stanza nel formato compilato */
+    void writeBinary(const std::string& path) const;
+
+    /**
+     * @brief Numero di file di stanza letti finora dal processo (JSON o binari)
+     *
+     * Strumentazione: permette di verificare quante volte un cambio stanza
+     * tocca il disco. Thread-safe.
+     */
+    static std::size_t loadCount();
+  };
+} // namespace lulu
@@ -0,0 +1,138 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Contenitore con handle generazionali e storage denso
+   *
+   * Gli elementi stanno in un array contiguo (items()), da scorrere senza
+   * buchi; ogni elemento è raggiungibile in O(1) tramite un ActorHandle
+   * {slot, generazione}. Gli slot liberati vengono riusati con una
+   * generazione nuova, quindi un handle di un elemento rimosso non
+   * restituisce mai l'elemento che ne ha preso il posto.
+   *
+   * eraseIf compatta l'array mantenendo l'ordine di inserimento (che per
+   * l'Arena è ordine di rendering e di simulazione).
+   *
+   * @tparam T Tipo degli elementi (deve essere spostabile)
+   */
+  template <typename T>
+  class SlotMap final
+  {
+    struct Slot
+    {
+      std::uint32_t generation{0};
+      std::uint32_t dense{0}; // Posizione in items_ (valida solo se lo slot è occupato)
+      bool occupied{false};
+    };
+
+    std::vector<T> items_;
+    std::vector<std::uint32_t> owners_; // owners_[i] = slot dell'elemento items_[i]
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_;
+
+  public:
+    /**
+     * @brief Inserisce un elemento in fondo all'array denso
+     *
+     * @return Handle stabile dell'elemento
+     */
+    ActorHandle insert(T value)
+    {
+      std::uint32_t index;
+      if (!free_.empty())
+      {
+        index = free_.back();
+        free_.pop_back();
+      }
+      else
+      {
+        index = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+      }
+
+      Slot& slot = slots_[index];
+      slot.dense = static_cast<std::uint32_t>(items_.size());
+      slot.occupied = true;
+      items_.push_back(std::move(value));
+      owners_.push_back(index);
+      return {index, slot.generation};
+    }
+
+    /** @brief Restituisce l'elemento dell'handle, oppure nullptr se l'handle è scaduto */
+    [[nodiscard]] T* get(const ActorHandle handle)
+    {
+      if (handle.index >= slots_.size()) return nullptr;
+      const Slot& slot = slots_[handle.index];
+      return slot.occupied && slot.generation == handle.generation ? &items_[slot.dense] : nullptr;
+    }
+
+    [[nodiscard]] const T* get(const ActorHandle handle) const
+    {
+      return const_cast<SlotMap*>(this)->get(handle);
+    }
+
+    /**
+     * @brief Posizione in items() dell'elemento di un handle valido
+     *
+     * Serve agli array paralleli a items() (es: TransformStore). Non
+     * controlla l'handle: va usato solo su elementi presenti.
+     */
+    [[nodiscard]] std::uint32_t denseIndex(const ActorHandle handle) const
+    {
+      return slots_[handle.index].dense;
+    }
+
+    /**
+     * @brief Rimuove tutti gli elementi che soddisfano pred, in una sola passata
+     *
+     * Gli elementi rimasti conservano l'ordine relativo; gli slot liberati
+     * cambiano generazione.
+     *
+     * @return Numero di elementi rimossi
+     */
+    template <typename Pred>
+    std::size_t eraseIf(Pred pred)
+    {
+      std::size_t out = 0;
+      for (std::size_t in = 0; in < items_.size(); ++in)
+      {
+        const std::uint32_t index = owners_[in];
+        if (pred(items_[in]))
+        {
+          Slot& slot = slots_[index];
+          slot.occupied = false;
+          ++slot.generation;
+          free_.push_back(index);
+          continue;
+        }
+
+        if (out != in)
+        {
+          items_[out] = std::move(items_[in]);
+          owners_[out] = index;
+        }
+        slots_[index].dense = static_cast<std::uint32_t>(out);
+        ++out;
+      }
+
+      const std::size_t removed = items_.size() - out;
+      items_.erase(items_.begin() + static_cast<std::ptrdiff_t>(out), items_.end());
+      owners_.resize(out);
+      return removed;
+    }
+
+    /** @brief Elementi in ordine di inserimento, senza buchi */
+    [[nodiscard]] std::span<T> items() { return items_; }
+    [[nodiscard]] std::span<const T> items() const { return items_; }
+
+    /** @brief Numero di slot allocati (limite superiore degli ActorHandle::index emessi) */
+    [[nodiscard]] std::size_t slotCount() const { return slots_.size(); }
+
+    [[nodiscard]] std::size_t size() const { return items_.size(); }
+  };
+} // namespace lulu
@@ -0,0 +1,101 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Griglia uniforme (spatial hash) per la broadphase delle collisioni
+   *
+   * Lo spazio è diviso in celle quadrate di lato cellSize; ogni attore è
+   * registrato in tutte le celle toccate dal suo rettangolo di collisione.
+   * Una query restituisce solo gli attori che condividono almeno una cella
+   * con il rettangolo richiesto: sono i candidati su cui eseguire poi
+   * il test di sovrapposizione (overlapBatch).
+   *
+   * La griglia non legge gli attori: riceve i rettangoli dal chiamante
+   * (l'Arena li prende dal suo TransformStore) e restituisce handle.
+   *
+   * Ogni attore porta con sé un numero d'ordine (l'ordine di spawn): i
+   * candidati vengono restituiti ordinati per questo numero, così l'Arena
+   * produce le collisioni nello stesso ordine della scansione completa.
+   */
+  class SpatialGrid final
+  {
+  public:
+    /**
+     * @brief Attore registrato nella griglia con il suo ordine di spawn
+     */
+    struct Entry
+    {
+      ActorHandle handle;
+      std::uint64_t order;
+    };
+
+  private:
+    // Intervallo di celle (estremi inclusi) coperto da un attore
+    struct CellRange
+    {
+      int minX, minY, maxX, maxY;
+
+      bool operator==(const CellRange&) const = default;
+    };
+
+    struct Registration
+    {
+      CellRange range;
+      Entry entry;
+      bool active{false};
+    };
+
+    float cellSize_;
+    std::unordered_map<std::int64_t, std::vector<Entry>> cells_;
+    std::vector<Registration> registrations_; // Per slot (ActorHandle::index)
+
+    [[nodiscard]] CellRange rangeOf(const Vec2<float>& pos, const Vec2<float>& size) const;
+    static std::int64_t cellKey(int x, int y);
+
+    void addToCells(const Entry& entry, const CellRange& range);
+    void removeFromCells(ActorHandle handle, const CellRange& range);
+
+  public:
+    /**
+     * @param cellSize Lato di una cella in pixel
+     */
+    explicit SpatialGrid(float cellSize = 64.0f);
+
+    /**
+     * @brief Registra un attore con la sua posizione e dimensione correnti
+     *
+     * @param handle Attore da registrare
+     * @param order Ordine di spawn, usato per ordinare i risultati delle query
+     * @param pos Angolo in alto a sinistra del rettangolo di collisione
+     * @param size Dimensioni del rettangolo di collisione
+     */
+    void insert(ActorHandle handle, std::uint64_t order, Vec2<float> pos, Vec2<float> size);
+
+    /** @brief Rimuove un attore dalla griglia (nessun effetto se assente) */
+    void remove(ActorHandle handle);
+
+    /**
+     * @brief Riallinea le celle di un attore dopo che si è mosso
+     *
+     * Se l'attore copre ancora le stesse celle non fa nulla.
+     */
+    void update(ActorHandle handle, Vec2<float> pos, Vec2<float> size);
+
+    /** @brief Svuota la griglia */
+    void clear();
+
+    /**
+     * @brief Raccoglie gli attori che condividono una cella con il rettangolo dato
+     *
+     * @param pos Angolo in alto a sinistra del rettangolo
+     * @param size Dimensioni del rettangolo
+     * @param out Vector di output (svuotato), senza duplicati e ordinato per ordine di spawn
+     */
+    void query(const Vec2<float>& pos, const Vec2<float>& size, std::vector<Entry>& out) const;
+  };
+} // namespace lulu
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace lulu
+{
+  /**
+   * @brief Identificatore compatto di una sprite
+   *
+   * Gli id sono densi (0, 1, 2, ...): il renderer può usarli direttamente
+   * come indice in un array di texture.
+   */
+  using SpriteId = std::uint32_t;
+
+  /** @brief Id riservato: l'attore non ha sprite (es: muri e porte invisibili) */
+  constexpr SpriteId NO_SPRITE = 0;
+
+  /**
+   * @brief Registro globale dei percorsi delle sprite
+   *
+   * Ogni percorso viene "internato" una volta sola, al caricamento, in un
+   * SpriteId. Durante il frame attori, animazioni e renderer si passano
+   * solo l'id: niente copie di stringhe né hash di percorsi.
+   *
+   * Thread-safe: le operazioni sono protette da un mutex.
+   */
+  class SpriteRegistry final
+  {
+  public:
+    SpriteRegistry() = delete;
+
+    /**
+     * @brief Restituisce l'id di un percorso, registrandolo se è nuovo
+     *
+     * @param path Percorso dell'immagine (stringa vuota = NO_SPRITE)
+     * @return Id stabile per tutta la durata del processo
+     */
+    static SpriteId intern(const std::string& path);
+
+    /**
+     * @brief Restituisce il percorso associato a un id
+     *
+     * Da usare al caricamento delle risorse, non nel frame.
+     *
+     * @param id Id restituito da intern()
+     * @return Percorso dell'immagine (vuoto per NO_SPRITE o id sconosciuti)
+     */
+    static const std::string& path(SpriteId id);
+
+    /** @brief Numero di id assegnati finora (NO_SPRITE compreso) */
+    static std::size_t size();
+  };
+} // namespace lulu
@@ -0,0 +1,60 @@
+#pragma once
+#include "aabbBatch.hpp"
+#include "spatialGrid.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Indice immutabile degli attori statici di una stanza
+   *
+   * Muri, porte e NPC non si muovono mai: invece di tenerli nella griglia
+   * dinamica vengono "cotti" una volta sola in una griglia densa in formato
+   * CSR (per ogni cella un intervallo in un unico array di indici).
+   * Una query non alloca e non fa lookup in hash map: calcola le celle
+   * toccate e legge gli intervalli corrispondenti.
+   *
+   * Come per SpatialGrid, i risultati sono ordinati per ordine di spawn.
+   */
+  class StaticIndex final
+  {
+    float minCellSize_;      // Dal costruttore: ogni build riparte da qui
+    float cellSize_;         // Della build corrente, raddoppiato se la stanza è enorme
+    Vec2<float> origin_{};   // Angolo in alto a sinistra della prima cella
+    int columns_{0}, rows_{0};
+
+    std::vector<SpatialGrid::Entry> items_;   // Attori statici, ordinati per spawn
+    std::vector<std::uint32_t> cellStart_;    // cellStart_[c]..cellStart_[c+1] = intervallo della cella c
+    std::vector<std::uint32_t> cellItems_;    // Indici in items_, cella per cella
+
+    mutable std::vector<std::uint32_t> scratch_;
+
+  public:
+    /**
+     * @param cellSize Lato minimo di una cella in pixel
+     */
+    explicit StaticIndex(float cellSize = 64.0f);
+
+    /**
+     * @brief Ricostruisce l'indice da zero
+     *
+     * @param statics Attori statici con il loro ordine di spawn, ordinati per spawn
+     * @param boxes Rettangoli di collisione: boxes[i] è quello di statics[i]
+     */
+    void build(std::vector<SpatialGrid::Entry> statics, const AabbBatch& boxes);
+
+    /** @brief Numero di attori indicizzati */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Raccoglie gli attori statici che condividono una cella con il rettangolo dato
+     *
+     * @param pos Angolo in alto a sinistra del rettangolo
+     * @param size Dimensioni del rettangolo
+     * @param out Vector di output (svuotato), senza duplicati e ordinato per ordine di spawn
+     */
+    void query(const Vec2<float>& pos, const Vec2<float>& size, std::vector<SpatialGrid::Entry>& out) const;
+  };
+} // namespace lulu
@@ -0,0 +1,101 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lulu
+{
+  /** @brief Proprietà di un tipo di tile, combinabili come bitmask */
+  enum TileFlag : std::uint8_t
+  {
+    TF_NONE = 0,
+    TF_SOLID = 1 << 0 // Blocca i Movable
+  };
+
+  /**
+   * @brief Griglia di tile di una stanza (sezione "tiles" dell'arena)
+   *
+   * Sostituisce i muri fatti di attori: ogni cella contiene l'indice di un
+   * tipo di tile, e ogni tipo dice se è solido e quale pezzo del tileset
+   * disegnare. Un Movable si risolve contro le celle che tocca, lette
+   * direttamente dalla griglia: il costo dipende dalla sua dimensione, non
+   * dal numero di muri della stanza.
+   *
+   * Un tipo senza source non viene disegnato (muro già dipinto nello sfondo).
+   */
+  struct TileMap
+  {
+    struct Tile
+    {
+      std::uint8_t flags{TF_NONE};
+      std::optional<Vec2<float>> source; // Angolo del tile nel tileset, in pixel
+    };
+
+    /** @brief Intervallo di celle (estremi inclusi) */
+    struct Range
+    {
+      int firstColumn{0}, firstRow{0};
+      int lastColumn{-1}, lastRow{-1}; // Vuoto se last < first
+
+      [[nodiscard]] bool empty() const { return lastColumn < firstColumn || lastRow < firstRow; }
+    };
+
+    /** @brief Cella vuota */
+    static constexpr std::uint16_t EMPTY = UINT16_MAX;
+
+    std::string tileset;    // Immagine da cui vengono i tile (es: "dungeon stylesheet.png")
+    float sourceSize{16};   // Lato di un tile nel tileset, in pixel
+    float tileSize{25};     // Lato di una cella nell'arena
+    Vec2<float> origin{};   // Angolo in alto a sinistra della griglia nell'arena
+    int columns{0}, rows{0};
+    std::vector<Tile> tiles;          // Tipi di tile, indicizzati dalle celle
+    std::vector<std::uint16_t> cells; // Riga per riga; EMPTY o indice in tiles
+
+    /** @brief La stanza non ha tile */
+    [[nodiscard]] bool empty() const;
+
+    /** @brief Almeno un tipo di tile va disegnato */
+    [[nodiscard]] bool visible() const;
+
+    /**
+     * @brief Controlla che le celle siano coerenti con dimensioni e tipi
+     *
+     * @throws std::runtime_error se la griglia non è valida
+     */
+    void validate() const;
+
+    /** @brief Tipo di tile di una cella, oppure nullptr se vuota o fuori dalla griglia */
+    [[nodiscard]] const Tile* at(int column, int row) const;
+
+    /**
+     * @brief Cambia il tipo di una cella (es: un muro che si apre)
+     *
+     * @param type Indice in tiles, oppure EMPTY
+     * @throws std::out_of_range se la cella è fuori dalla griglia o il tipo non esiste
+     */
+    void set(int column, int row, std::uint16_t type);
+
+    /** @brief La cella blocca i Movable (fuori dalla griglia: no) */
+    [[nodiscard]] bool solid(int column, int row) const;
+
+    /** @brief Angolo in alto a sinistra di una cella nell'arena */
+    [[nodiscard]] Vec2<float> cellPos(int column, int row) const;
+
+    /** @brief Celle che intersecano un rettangolo, già limitate alla griglia */
+    [[nodiscard]] Range range(const Vec2<float>& pos, const Vec2<float>& size) const;
+
+    /**
+     * @brief Direzione da cui un rettangolo urta una cella solida
+     *
+     * Come Actor::checkCollision, vince l'asse con la penetrazione minore,
+     * ma un lato che confina con un'altra cella solida non viene mai scelto:
+     * è interno al muro, e spingere da lì farebbe "inciampare" chi scivola
+     * lungo un muro fatto di più celle.
+     *
+     * @return D_NONE se il rettangolo non si sovrappone alla cella
+     */
+    [[nodiscard]] Direction collision(int column, int row, const Vec2<float>& pos, const Vec2<float>& size) const;
+  };
+} // namespace lulu
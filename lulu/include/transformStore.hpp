@@ -0,0 +1,92 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace lulu
+{
+  /**
+   * @brief Posizioni, rettangoli di collisione e velocità degli attori di un'Arena, in SoA
+   *
+   * Ogni componente sta in un proprio array contiguo. Gli array sono
+   * densi e paralleli a SlotMap::items() dell'arena: l'elemento i è
+   * l'attore Arena::actors()[i], quindi non ci sono buchi e l'ordine è
+   * quello di spawn. Finché un attore è nell'arena questi array sono la
+   * sua unica copia della geometria: gli accessor di Actor li leggono e
+   * scrivono tramite l'indice che l'arena gli assegna.
+   *
+   * Broadphase, impacchettamento dei candidati per overlapBatch e
+   * rendering leggono da qui senza passare dagli oggetti Actor.
+   */
+  class TransformStore final
+  {
+    std::vector<float> x_, y_;           // Posizione (angolo in alto a sinistra)
+    std::vector<float> prevX_, prevY_;   // Posizione all'inizio del tick corrente
+    std::vector<float> w_, h_;           // Dimensioni del rettangolo di collisione
+    std::vector<float> speedX_, speedY_; // Velocità in pixel per tick (zero per gli statici)
+
+  public:
+    /**
+     * @brief Aggiunge un attore in fondo agli array
+     *
+     * @return Indice dell'attore (uguale alla sua posizione in SlotMap::items())
+     */
+    std::uint32_t push(Vec2<float> pos, Vec2<float> prevPos, Vec2<float> size, Vec2<float> speed);
+
+    /**
+     * @brief Rimuove gli indici per cui pred(i) è vero, in una sola passata
+     *
+     * Compatta come SlotMap::eraseIf: gli elementi rimasti conservano
+     * l'ordine relativo. Va chiamato con lo stesso criterio e prima della
+     * eraseIf della SlotMap, così i due array restano paralleli.
+     *
+     * @return Numero di elementi rimossi
+     */
+    template <typename Pred>
+    std::size_t eraseIf(Pred pred)
+    {
+      std::size_t out = 0;
+      for (std::size_t in = 0; in < x_.size(); ++in)
+      {
+        if (pred(in)) continue;
+
+        if (out != in)
+        {
+          for (auto* component : {&x_, &y_, &prevX_, &prevY_, &w_, &h_, &speedX_, &speedY_})
+            (*component)[out] = (*component)[in];
+        }
+        ++out;
+      }
+
+      const std::size_t removed = x_.size() - out;
+      for (auto* component : {&x_, &y_, &prevX_, &prevY_, &w_, &h_, &speedX_, &speedY_})
+        component->resize(out);
+      return removed;
+    }
+
+    /** @brief Copia la posizione corrente in quella precedente per tutti gli attori */
+    void storePrevPositions();
+
+    [[nodiscard]] std::size_t size() const { return x_.size(); }
+
+    [[nodiscard]] Vec2<float> pos(const std::uint32_t i) const { return {x_[i], y_[i]}; }
+    [[nodiscard]] Vec2<float> prevPos(const std::uint32_t i) const { return {prevX_[i], prevY_[i]}; }
+    [[nodiscard]] Vec2<float> size(const std::uint32_t i) const { return {w_[i], h_[i]}; }
+    [[nodiscard]] Vec2<float> speed(const std::uint32_t i) const { return {speedX_[i], speedY_[i]}; }
+
+    /** @brief Posizione tra il tick precedente e quello corrente (vedi Actor::interpolatedPos) */
+    [[nodiscard]] Vec2<float> interpolatedPos(std::uint32_t i, float alpha) const;
+
+    void setPos(const std::uint32_t i, const Vec2<float> pos) { x_[i] = pos.x; y_[i] = pos.y; }
+    void setPrevPos(const std::uint32_t i, const Vec2<float> pos) { prevX_[i] = pos.x; prevY_[i] = pos.y; }
+    void setSize(const std::uint32_t i, const Vec2<float> size) { w_[i] = size.x; h_[i] = size.y; }
+    void setSpeed(const std::uint32_t i, const Vec2<float> speed) { speedX_[i] = speed.x; speedY_[i] = speed.y; }
+
+    // === ACCESSO DIRETTO AGLI ARRAY ===
+
+    [[nodiscard]] const float* x() const { return x_.data(); }
+    [[nodiscard]] const float* y() const { return y_.data(); }
+    [[nodiscard]] const float* w() const { return w_.data(); }
+    [[nodiscard]] const float* h() const { return h_.data(); }
+  };
+} // namespace lulu
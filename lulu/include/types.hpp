@@ -1,4 +1,8 @@
 #pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <cmath>
 #include <type_traits>
@@ -118,12 +122,33 @@ enum Key
     K_UP = 265      // Freccia su
 };
 
+/** @brief Tutti i tasti gestiti, nell'ordine dei bit di KeyMask */
+constexpr std::array<Key, 11> KEYS{
+    K_SPACE, K_A, K_D, K_S, K_W, K_ENTER, K_ESCAPE, K_RIGHT, K_LEFT, K_DOWN, K_UP
+};
+
+/**
+ * @brief Insieme di tasti premuti, un bit per tasto (bit i = KEYS[i])
+ *
+ * Forma compatta degli input di un tick: si confronta, si salva su file
+ * e si combina con semplici operazioni sui bit.
+ */
+using KeyMask = std::uint32_t;
+
+/** @brief Bit di un tasto in KeyMask (0 se il tasto non è gestito) */
+constexpr KeyMask keyBit(const Key key)
+{
+    for (std::size_t i = 0; i < KEYS.size(); ++i)
+        if (KEYS[i] == key) return KeyMask{1} << i;
+    return 0;
+}
+
 /**
  * @brief Stati di animazione per gli attori
  * 
  * Determinano quale set di animazioni deve essere riprodotto.
  */
-enum State
+enum State : std::uint8_t
 {
     S_STILL,    // Fermo (idle)
     S_MOVING,   // In movimento
@@ -131,13 +156,16 @@ enum State
     S_HURT      // Ferito
 };
 
+/** @brief Numero di valori di State */
+constexpr std::size_t STATE_COUNT = 4;
+
 /**
  * @brief Direzioni di movimento e collisioni
  * 
  * Supporta 8 direzioni (cardinali + diagonali) più NONE.
  * Usato sia per movimento che per determinare da che lato avviene una collisione.
  */
-enum Direction
+enum Direction : std::uint8_t
 {
     D_NONE,      // Nessun movimento
     D_UP,        // Su
@@ -150,6 +178,56 @@ enum Direction
     D_DOWNRIGHT  // Diagonale giù-destra
 };
 
+/** @brief Numero di valori di Direction (D_NONE compreso) */
+constexpr std::size_t DIRECTION_COUNT = 9;
+
+/**
+ * @brief Categorie di attore, combinabili come bitmask
+ *
+ * Vengono impostate una volta sola nei costruttori: riconoscere il tipo di
+ * un attore diventa un AND sui bit invece di un dynamic_cast.
+ *
+ * Alcuni bit sono categorie condivise da più tipi (AK_MOVABLE, AK_ENEMY),
+ * altri identificano un tipo e le sue sottoclassi: solo questi ultimi
+ * possono fare da KIND per Actor::as<T>().
+ */
+enum ActorKind : std::uint8_t
+{
+    AK_NONE = 0,
+    AK_MOVABLE = 1 << 0,  // Viene mosso dall'Arena a ogni tick
+    AK_FIGHTER = 1 << 1,  // Ha HP e può attaccare
+    AK_DOOR = 1 << 2,     // Porta verso un'altra stanza
+    AK_NPC = 1 << 3,      // Personaggio con dialogo
+    AK_PLAYER = 1 << 4,   // Controllato dal giocatore
+    AK_ENEMY = 1 << 5,    // Nemico (categoria: non identifica un tipo)
+    AK_ZOL = 1 << 6       // Zol
+};
+
+/** @brief Numero di bit usati da ActorKind */
+constexpr std::size_t ACTOR_KIND_COUNT = 7;
+
+/** @brief Indice (0-based) del bit di una categoria singola */
+constexpr std::size_t kindIndex(const ActorKind kind) { return std::countr_zero(static_cast<unsigned>(kind)); }
+
+/**
+ * @brief Riferimento stabile a un attore dell'Arena
+ *
+ * A differenza di un Actor*, un handle non punta mai a memoria liberata:
+ * quando l'attore viene rimosso la generazione del suo slot avanza, e
+ * Arena::get restituisce nullptr per tutti gli handle vecchi. Un handle
+ * vale solo nell'Arena che l'ha emesso.
+ */
+struct ActorHandle
+{
+    std::uint32_t index{UINT32_MAX}; // Slot nell'Arena
+    std::uint32_t generation{0};     // Generazione dello slot al momento dello spawn
+
+    /** @brief L'handle è stato emesso da un'Arena (non dice se l'attore è ancora vivo) */
+    [[nodiscard]] constexpr bool valid() const { return index != UINT32_MAX; }
+
+    constexpr bool operator==(const ActorHandle&) const = default;
+};
+
 /**
  * @brief Struttura che rappresenta una collisione
  * 
@@ -158,7 +236,7 @@ enum Direction
  */
 struct Collision
 {
-    Actor *target;                    // L'attore con cui si è colliduto
+    ActorHandle target;               // L'attore con cui si è colliduto (vedi Arena::get)
     Direction collisionDirection;     // Da che direzione è avvenuta la collisione
 };
 
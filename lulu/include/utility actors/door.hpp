@@ -24,6 +24,8 @@ namespace lulu
     bool changeMusic_;        // Se cambiare la musica insieme alla stanza
 
   public:
+    static constexpr ActorKind KIND = AK_DOOR;
+
     /**
      * @brief Costruttore per porta con tutti i parametri
      *
@@ -40,6 +42,7 @@ namespace lulu
           destination_(destination),
           changeMusic_(changeMusic)
     {
+        kind_ |= AK_DOOR;
     }
 
     // === GETTERS ===
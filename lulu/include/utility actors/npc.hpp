@@ -21,6 +21,8 @@ namespace lulu
         std::string name_;
 
     public:
+        static constexpr ActorKind KIND = AK_NPC;
+
         NPC(const Vec2<float>& pos, const Vec2<float>& size, const std::string& sprite,
     const std::string& dialoguePath, const std::string& name);
 
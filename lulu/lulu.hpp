@@ -3,7 +3,21 @@
 #include "arena.hpp"
 #include "types.hpp"
 #include "animationHandler.hpp"
+#include "animationTable.hpp"
+#include "characterConfig.hpp"
+#include "inputLog.hpp"
+#include "roomData.hpp"
+#include "binaryIo.hpp"
+#include "atlas.hpp"
+#include "backgroundChunks.hpp"
+#include "aabbBatch.hpp"
+#include "transformStore.hpp"
+#include "radixSort.hpp"
+#include "tileMap.hpp"
+#include "spriteRegistry.hpp"
 #include "movable.hpp"
+#include "rng.hpp"
+#include "slotMap.hpp"
 #include "fighters/fighter.hpp"
 #include "fighters/link.hpp"
 #include "utility actors/door.hpp"
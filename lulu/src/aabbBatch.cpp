@@ -0,0 +1,238 @@
+#include "aabbBatch.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace lulu
+{
+    namespace
+    {
+        // Stessa sequenza di operazioni di Actor::checkCollision: i risultati coincidono bit per bit
+        Direction classify(const Vec2<float> pos, const Vec2<float> size,
+                           const float ox, const float oy, const float ow, const float oh)
+        {
+            const float x = pos.x + size.x;
+            const float y = pos.y + size.y;
+            const float otherMaxX = ox + ow;
+            const float otherMaxY = oy + oh;
+
+            if (x <= ox || otherMaxX <= pos.x || y <= oy || otherMaxY <= pos.y)
+                return D_NONE;
+
+            const float minH = std::min(std::abs(x - ox), std::abs(otherMaxX - pos.x));
+            const float minV = std::min(std::abs(y - oy), std::abs(otherMaxY - pos.y));
+
+            const float thisCenterX = pos.x + size.x / 2.0f;
+            const float thisCenterY = pos.y + size.y / 2.0f;
+            const float otherCenterX = ox + ow / 2.0f;
+            const float otherCenterY = oy + oh / 2.0f;
+
+            if (minH <= minV)
+                return thisCenterX <= otherCenterX ? D_RIGHT : D_LEFT;
+
+            return thisCenterY <= otherCenterY ? D_DOWN : D_UP;
+        }
+
+#if defined(__AVX__) || defined(__SSE2__)
+        // Scrive il risultato della corsia i a partire dai bit estratti dal kernel vettoriale
+        std::size_t store(const std::size_t i, const int lanes, const int hit, const int horizontal,
+                          const int right, const int down, std::uint64_t* hitMask, Direction* directions)
+        {
+            std::size_t hits = 0;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                if (!(hit >> lane & 1))
+                {
+                    directions[i + lane] = D_NONE;
+                    continue;
+                }
+
+                const bool h = horizontal >> lane & 1;
+                directions[i + lane] = h ? (right >> lane & 1 ? D_RIGHT : D_LEFT)
+                                         : (down >> lane & 1 ? D_DOWN : D_UP);
+                hitMask[(i + lane) / 64] |= std::uint64_t{1} << ((i + lane) % 64);
+                ++hits;
+            }
+            return hits;
+        }
+#endif
+
+        std::size_t scalarRange(const Vec2<float> pos, const Vec2<float> size, const AabbBatch& batch,
+                                const std::size_t begin, std::uint64_t* hitMask, Direction* directions)
+        {
+            std::size_t hits = 0;
+            for (std::size_t i = begin; i < batch.size(); ++i)
+            {
+                directions[i] = classify(pos, size, batch.x()[i], batch.y()[i], batch.w()[i], batch.h()[i]);
+                if (directions[i] != D_NONE)
+                {
+                    hitMask[i / 64] |= std::uint64_t{1} << (i % 64);
+                    ++hits;
+                }
+            }
+            return hits;
+        }
+
+        void clearMask(const std::size_t count, std::uint64_t* hitMask)
+        {
+            std::fill_n(hitMask, (count + 63) / 64, std::uint64_t{0});
+        }
+    }
+
+    void AabbBatch::clear()
+    {
+        x_.clear();
+        y_.clear();
+        w_.clear();
+        h_.clear();
+    }
+
+    void AabbBatch::push(const Vec2<float> pos, const Vec2<float> size)
+    {
+        x_.push_back(pos.x);
+        y_.push_back(pos.y);
+        w_.push_back(size.x);
+        h_.push_back(size.y);
+    }
+
+    std::size_t overlapBatchScalar(const Vec2<float> pos, const Vec2<float> size, const AabbBatch& batch,
+                                   std::uint64_t* hitMask, Direction* directions)
+    {
+        clearMask(batch.size(), hitMask);
+        return scalarRange(pos, size, batch, 0, hitMask, directions);
+    }
+
+#if defined(__AVX__)
+    std::size_t overlapBatch(const Vec2<float> pos, const Vec2<float> size, const AabbBatch& batch,
+                             std::uint64_t* hitMask, Direction* directions)
+    {
+        clearMask(batch.size(), hitMask);
+
+        const __m256 px = _mm256_set1_ps(pos.x);
+        const __m256 py = _mm256_set1_ps(pos.y);
+        const __m256 maxX = _mm256_set1_ps(pos.x + size.x);
+        const __m256 maxY = _mm256_set1_ps(pos.y + size.y);
+        const __m256 centerX = _mm256_set1_ps(pos.x + size.x / 2.0f);
+        const __m256 centerY = _mm256_set1_ps(pos.y + size.y / 2.0f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+
+        std::size_t hits = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= batch.size(); i += 8)
+        {
+            const __m256 ox = _mm256_loadu_ps(batch.x() + i);
+            const __m256 oy = _mm256_loadu_ps(batch.y() + i);
+            const __m256 ow = _mm256_loadu_ps(batch.w() + i);
+            const __m256 oh = _mm256_loadu_ps(batch.h() + i);
+            const __m256 otherMaxX = _mm256_add_ps(ox, ow);
+            const __m256 otherMaxY = _mm256_add_ps(oy, oh);
+
+            // !(a <= b) e non (a > b): con i NaN deve comportarsi come il test scalare
+            const __m256 hit = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(maxX, ox, _CMP_NLE_UQ), _mm256_cmp_ps(otherMaxX, px, _CMP_NLE_UQ)),
+                _mm256_and_ps(_mm256_cmp_ps(maxY, oy, _CMP_NLE_UQ), _mm256_cmp_ps(otherMaxY, py, _CMP_NLE_UQ)));
+            const int hitBits = _mm256_movemask_ps(hit);
+            if (hitBits == 0)
+            {
+                std::fill_n(directions + i, 8, D_NONE);
+                continue;
+            }
+
+            // min_ps(b, a) == std::min(a, b) anche con zeri di segno diverso e NaN
+            const __m256 minH = _mm256_min_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(otherMaxX, px)),
+                                              _mm256_andnot_ps(sign, _mm256_sub_ps(maxX, ox)));
+            const __m256 minV = _mm256_min_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(otherMaxY, py)),
+                                              _mm256_andnot_ps(sign, _mm256_sub_ps(maxY, oy)));
+            const __m256 otherCenterX = _mm256_add_ps(ox, _mm256_div_ps(ow, two));
+            const __m256 otherCenterY = _mm256_add_ps(oy, _mm256_div_ps(oh, two));
+
+            hits += store(i, 8, hitBits,
+                          _mm256_movemask_ps(_mm256_cmp_ps(minH, minV, _CMP_LE_OQ)),
+                          _mm256_movemask_ps(_mm256_cmp_ps(centerX, otherCenterX, _CMP_LE_OQ)),
+                          _mm256_movemask_ps(_mm256_cmp_ps(centerY, otherCenterY, _CMP_LE_OQ)),
+                          hitMask, directions);
+        }
+
+        return hits + scalarRange(pos, size, batch, i, hitMask, directions);
+    }
+
+    const char* overlapBatchIsa()
+    {
+        return "avx";
+    }
+#elif defined(__SSE2__)
+    std::size_t overlapBatch(const Vec2<float> pos, const Vec2<float> size, const AabbBatch& batch,
+                             std::uint64_t* hitMask, Direction* directions)
+    {
+        clearMask(batch.size(), hitMask);
+
+        const __m128 px = _mm_set1_ps(pos.x);
+        const __m128 py = _mm_set1_ps(pos.y);
+        const __m128 maxX = _mm_set1_ps(pos.x + size.x);
+        const __m128 maxY = _mm_set1_ps(pos.y + size.y);
+        const __m128 centerX = _mm_set1_ps(pos.x + size.x / 2.0f);
+        const __m128 centerY = _mm_set1_ps(pos.y + size.y / 2.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+
+        std::size_t hits = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= batch.size(); i += 4)
+        {
+            const __m128 ox = _mm_loadu_ps(batch.x() + i);
+            const __m128 oy = _mm_loadu_ps(batch.y() + i);
+            const __m128 ow = _mm_loadu_ps(batch.w() + i);
+            const __m128 oh = _mm_loadu_ps(batch.h() + i);
+            const __m128 otherMaxX = _mm_add_ps(ox, ow);
+            const __m128 otherMaxY = _mm_add_ps(oy, oh);
+
+            // !(a <= b) e non (a > b): con i NaN deve comportarsi come il test scalare
+            const __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmpnle_ps(maxX, ox), _mm_cmpnle_ps(otherMaxX, px)),
+                _mm_and_ps(_mm_cmpnle_ps(maxY, oy), _mm_cmpnle_ps(otherMaxY, py)));
+            const int hitBits = _mm_movemask_ps(hit);
+            if (hitBits == 0)
+            {
+                std::fill_n(directions + i, 4, D_NONE);
+                continue;
+            }
+
+            // min_ps(b, a) == std::min(a, b) anche con zeri di segno diverso e NaN
+            const __m128 minH = _mm_min_ps(_mm_andnot_ps(sign, _mm_sub_ps(otherMaxX, px)),
+                                           _mm_andnot_ps(sign, _mm_sub_ps(maxX, ox)));
+            const __m128 minV = _mm_min_ps(_mm_andnot_ps(sign, _mm_sub_ps(otherMaxY, py)),
+                                           _mm_andnot_ps(sign, _mm_sub_ps(maxY, oy)));
+            const __m128 otherCenterX = _mm_add_ps(ox, _mm_div_ps(ow, two));
+            const __m128 otherCenterY = _mm_add_ps(oy, _mm_div_ps(oh, two));
+
+            hits += store(i, 4, hitBits,
+                          _mm_movemask_ps(_mm_cmple_ps(minH, minV)),
+                          _mm_movemask_ps(_mm_cmple_ps(centerX, otherCenterX)),
+                          _mm_movemask_ps(_mm_cmple_ps(centerY, otherCenterY)),
+                          hitMask, directions);
+        }
+
+        return hits + scalarRange(pos, size, batch, i, hitMask, directions);
+    }
+
+    const char* overlapBatchIsa()
+    {
+        return "sse2";
+    }
+#else
+    std::size_t overlapBatch(const Vec2<float> pos, const Vec2<float> size, const AabbBatch& batch,
+                             std::uint64_t* hitMask, Direction* directions)
+    {
+        return overlapBatchScalar(pos, size, batch, hitMask, directions);
+    }
+
+    const char* overlapBatchIsa()
+    {
+        return "scalar";
+    }
+#endif
+} // namespace lulu
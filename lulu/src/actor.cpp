@@ -1,53 +1,41 @@
 #include "actor.hpp"
 #include "arena.hpp"
+#include "characterConfig.hpp"
 #include <algorithm>
-#include <fstream>
-#include <nlohmann/json.hpp>
 
 namespace lulu
 {
-    Actor::Actor(const Vec2<float> pos, const Vec2<float> size, const std::string& sprite)
-        : pos_(pos), size_(size), sprite_(sprite), arena_(nullptr)
+    Actor::Actor(const Vec2<float> pos, const Vec2<float> size, const std::string& sprite, const Vec2<float> speed)
+        : sprite_(SpriteRegistry::intern(sprite)), arena_(nullptr), spawnPos_(pos), spawnSize_(size), spawnSpeed_(speed)
     {
     }
 
-    Actor::Actor(Vec2<float> pos, const std::string& configPath) : pos_(pos), arena_(nullptr)
+    Actor::Actor(const Vec2<float> pos, const CharacterConfig& config)
+        : sprite_(config.sprite), arena_(nullptr), spawnPos_(pos), spawnSize_(config.size), spawnSpeed_(config.speed)
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
-        {
-            throw std::runtime_error("Could not open config file: " + configPath);
-        }
-
-        nlohmann::json j;
-        f >> j;
-
-        const auto actorJson = j.at("actor");
-
-        sprite_ = actorJson.at("sprite").get<std::string>();
+    }
 
-        float width = actorJson.at("size").at("width").get<float>();
-        float height = actorJson.at("size").at("height").get<float>();
-        size_ = Vec2{width, height};
+    Vec2<float> Actor::pos() const
+    {
+        return transforms_->pos(transform_);
+    }
 
-        /*
-        float x = actorJson.at("pos").at("x").get<float>();
-        float y = actorJson.at("pos").at("y").get<float>();
-        pos_ = Vec2{x, y};
-        */
+    Vec2<float> Actor::interpolatedPos(const float alpha) const
+    {
+        return transforms_->interpolatedPos(transform_, alpha);
     }
 
-    const Vec2<float>& Actor::pos() const
+    Vec2<float> Actor::size() const
     {
-        return pos_;
+        return transforms_->size(transform_);
     }
 
-    const Vec2<float>& Actor::size() const
+    Vec2<float> Actor::speed() const
     {
-        return size_;
+        return transforms_->speed(transform_);
     }
 
-    const std::string& Actor::sprite() const
+    SpriteId Actor::sprite() const
     {
         return sprite_;
     }
@@ -57,9 +45,64 @@ namespace lulu
         return arena_;
     }
 
-    void Actor::setPos(Vec2<float> pos)
+    ActorHandle Actor::handle() const
+    {
+        return handle_;
+    }
+
+    bool Actor::isPendingKill() const
+    {
+        return pendingKill_;
+    }
+
+    std::uint8_t Actor::kind() const
+    {
+        return kind_;
+    }
+
+    bool Actor::is(const ActorKind kind) const
+    {
+        return (kind_ & kind) != 0;
+    }
+
+    Movable* Actor::asMovable()
     {
-        pos_ = pos;
+        return nullptr;
+    }
+
+    void Actor::setPos(const Vec2<float> pos)
+    {
+        moveTo(pos);
+        transforms_->setPrevPos(transform_, pos);
+    }
+
+    void Actor::translate(const Vec2<float> delta)
+    {
+        moveTo(pos() + delta);
+    }
+
+    void Actor::moveTo(const Vec2<float> pos)
+    {
+        transforms_->setPos(transform_, pos);
+    }
+
+    void Actor::setSprite(const SpriteId sprite)
+    {
+        if (sprite == sprite_) return;
+
+        sprite_ = sprite;
+        if (arena_ && !is(AK_MOVABLE))
+            arena_->invalidate(pos(), size());
+    }
+
+    void Actor::setSize(const Vec2<float> size)
+    {
+        transforms_->setSize(transform_, size);
+    }
+
+    void Actor::setSpeed(const Vec2<float> speed)
+    {
+        transforms_->setSpeed(transform_, speed);
     }
 
     void Actor::setArena(Arena* arena)
@@ -77,32 +120,34 @@ namespace lulu
         if (!other)
             return D_NONE;
 
-        // Get other actor's bounds
-        const auto& [ox, oy] = other->pos();
-        const auto& [ow, oh] = other->size();
+        // Get both actors' bounds
+        const Vec2<float> pos = this->pos();
+        const Vec2<float> size = this->size();
+        const auto [ox, oy] = other->pos();
+        const auto [ow, oh] = other->size();
         // Calculate bounding box corners
-        const auto [x, y] = pos_ + size_;
+        const auto [x, y] = pos + size;
         const Vec2 otherMax = {ox + ow, oy + oh};
 
         // AABB collision detection - check if boxes don't overlap
-        if (x <= ox || otherMax.x <= pos_.x || y <= oy || otherMax.y <= pos_.y)
+        if (x <= ox || otherMax.x <= pos.x || y <= oy || otherMax.y <= pos.y)
         {
             return D_NONE;
         }
 
         // Calculate penetration depths for each side
         const float leftDist = std::abs(x - ox); // Distance from our right to their left
-        const float rightDist = std::abs(otherMax.x - pos_.x); // Distance from our left to their right
+        const float rightDist = std::abs(otherMax.x - pos.x); // Distance from our left to their right
         const float topDist = std::abs(y - oy); // Distance from our bottom to their top
-        const float bottomDist = std::abs(otherMax.y - pos_.y); // Distance from our top to their bottom
+        const float bottomDist = std::abs(otherMax.y - pos.y); // Distance from our top to their bottom
 
         // Find minimum penetration distances
         const float minH = std::min(leftDist, rightDist); // Minimum horizontal penetration
         const float minV = std::min(topDist, bottomDist); // Minimum vertical penetration
 
         // Calculate centers to determine collision direction
-        const Vec2<float> thisCenter = pos_ + size_ / 2.0f;
-        const Vec2<float> otherCenter = other->pos() + other->size() / 2.0f;
+        const Vec2<float> thisCenter = pos + size / 2.0f;
+        const Vec2<float> otherCenter = Vec2{ox, oy} + Vec2{ow, oh} / 2.0f;
 
         // Return collision type based on minimum penetration
         if (minH <= minV)
@@ -113,28 +158,54 @@ namespace lulu
 
     void Actor::handleCollision(Collision collision)
     {
-        const Actor* other = collision.target;
+        const Actor* other = arena_ ? arena_->get(collision.target) : nullptr;
+        if (!other) return;
 
-        const auto& otherPos = other->pos();
-        const auto& otherSize = other->size();
+        pushOut(other->pos(), other->size(), collision.collisionDirection);
+    }
+
+    void Actor::handleTileCollision(const Vec2<float> tilePos, const Vec2<float> tileSize, const Direction direction)
+    {
+        pushOut(tilePos, tileSize, direction);
+    }
+
+    void Actor::pushOut(const Vec2<float> otherPos, const Vec2<float> otherSize, const Direction direction)
+    {
+        const Vec2<float> size = this->size();
+        Vec2<float> pos = this->pos();
 
         // Adjust position based on collision direction to prevent overlap
-        switch (collision.collisionDirection)
+        switch (direction)
         {
         case D_UP:
-            pos_.y = otherPos.y + otherSize.y;
+            pos.y = otherPos.y + otherSize.y;
             break;
         case D_DOWN:
-            pos_.y = otherPos.y - size_.y;
+            pos.y = otherPos.y - size.y;
             break;
         case D_LEFT:
-            pos_.x = otherPos.x + otherSize.x;
+            pos.x = otherPos.x + otherSize.x;
             break;
         case D_RIGHT:
-            pos_.x = otherPos.x - size_.x;
+            pos.x = otherPos.x - size.x;
             break;
         default:
-            break;
+            return;
         }
+        moveTo(pos);
+    }
+
+    void ActorDeleter::operator()(Actor* actor) const
+    {
+        if (!resource)
+        {
+            delete actor;
+            return;
+        }
+
+        // Il blocco allocato inizia all'oggetto più derivato, non per forza al sotto-oggetto Actor
+        void* block = dynamic_cast<void*>(actor);
+        actor->~Actor();
+        resource->deallocate(block, bytes, alignment);
     }
 } // namespace lulu
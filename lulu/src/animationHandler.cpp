@@ -1,8 +1,14 @@
 #include "animationHandler.hpp"
+#include <atomic>
 #include <cstring>
 
 namespace lulu
 {
+    namespace
+    {
+        std::atomic<std::size_t> reads{0};
+    }
+
     AnimationHandler::AnimationHandler() : movementDirection_(D_NONE), frame_(0), state_(S_STILL), enabled_(false)
     {
     }
@@ -25,7 +31,7 @@ namespace lulu
         return movementDirection_;
     }
 
-    std::uint8_t AnimationHandler::currentFrame() const
+    std::uint16_t AnimationHandler::currentFrame() const
     {
         return frame_;
     }
@@ -46,15 +52,17 @@ namespace lulu
     }
 
     // === Animation control ===
-    const std::vector<std::string> &AnimationHandler::currentAnimation() const
+    std::span<const AnimationFrame> AnimationHandler::currentAnimation() const
     {
-        return animationSet_.at(state_).at(movementDirection_);
+        if (!table_)
+            return {};
+        return table_->clip(state_, movementDirection_);
     }
 
-    void AnimationHandler::addAnimation(const State state, const Direction direction,
-                                        const std::vector<std::string> &animation)
+    void AnimationHandler::setTable(const AnimationTable *table)
     {
-        animationSet_[state][direction] = animation;
+        table_ = table;
+        frame_ = 0;
     }
 
     void AnimationHandler::set(const State newState, const Direction newDirection)
@@ -64,22 +72,31 @@ namespace lulu
         frame_ = 0;
     }
 
-    std::string AnimationHandler::nextSprite()
+    SpriteId AnimationHandler::nextSprite()
     {
+        return nextFrame().sprite;
+    }
+
+    const AnimationFrame &AnimationHandler::nextFrame()
+    {
+        static constexpr AnimationFrame empty{NO_SPRITE, {}};
+
         // Validate animation data exists
-        if (animationSet_.empty() || animationSet_[state_].empty() || animationSet_[state_][movementDirection_].empty())
+        const auto animation = currentAnimation();
+        if (animation.empty())
         {
-            return "";
+            return empty;
         }
 
-        // Get current sprite and advance frame counter
-        std::string sprite = animationSet_[state_][movementDirection_][frame_];
-        frame_ = (frame_ + 1) % animationSet_[state_][movementDirection_].size();
-        return sprite;
+        // Get current frame and advance frame counter
+        const AnimationFrame &frame = animation[frame_];
+        frame_ = (frame_ + 1) % animation.size();
+        return frame;
     }
 
     std::optional<Vec2<float>> AnimationHandler::getSpriteDimension(const std::string &filepath)
     {
+        reads.fetch_add(1, std::memory_order_relaxed);
         std::ifstream file(filepath, std::ios::binary);
         if (!file)
             return std::nullopt;
@@ -107,4 +124,9 @@ namespace lulu
 
         return Vec2(width, height).convert<float>();
     }
+
+    std::size_t AnimationHandler::readCount()
+    {
+        return reads.load(std::memory_order_relaxed);
+    }
 } // namespace lulu
@@ -0,0 +1,58 @@
+#include "animationTable.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace lulu
+{
+    namespace
+    {
+        bool sameFrame(const AnimationFrame& a, const AnimationFrame& b)
+        {
+            return a.sprite == b.sprite && a.size.x == b.size.x && a.size.y == b.size.y;
+        }
+    }
+
+    void AnimationTable::set(const State state, const Direction direction, const std::span<const AnimationFrame> frames)
+    {
+        Clip& clip = clips_[state][direction];
+        if (frames.empty())
+        {
+            clip = {};
+            return;
+        }
+
+        // Riusa una sequenza identica se è già nella tabella
+        const auto existing = std::ranges::search(frames_, frames, sameFrame);
+        if (!existing.empty())
+        {
+            clip.first = static_cast<std::uint16_t>(existing.begin() - frames_.begin());
+        }
+        else
+        {
+            // Le clip indicizzano frames_ con 16 bit: oltre, first e count si avvolgerebbero
+            if (frames_.size() + frames.size() > std::numeric_limits<std::uint16_t>::max())
+                throw std::length_error("AnimationTable: more than 65535 frames");
+
+            clip.first = static_cast<std::uint16_t>(frames_.size());
+            frames_.insert(frames_.end(), frames.begin(), frames.end());
+        }
+        clip.count = static_cast<std::uint16_t>(frames.size());
+    }
+
+    std::span<const AnimationFrame> AnimationTable::clip(const State state, const Direction direction) const
+    {
+        const Clip& clip = clips_[state][direction];
+        return {frames_.data() + clip.first, clip.count};
+    }
+
+    bool AnimationTable::contains(const SpriteId sprite) const
+    {
+        return std::ranges::find(frames_, sprite, &AnimationFrame::sprite) != frames_.end();
+    }
+
+    std::size_t AnimationTable::frameCount() const
+    {
+        return frames_.size();
+    }
+} // namespace lulu
@@ -3,221 +3,440 @@
 #include "movable.hpp"
 #include "utility actors/door.hpp"
 #include "utility actors/npc.hpp"
-#include <fstream>
-#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
 #include <utility>
 
 #include "fighters/zol.hpp"
 
 namespace lulu
 {
-    Arena::Arena(const Vec2<float> pos, const Vec2<float> size) : pos_(pos), size_(size)
+    Arena::Arena(const Vec2<float> pos, const Vec2<float> size, const std::uint64_t seed)
+        : pos_(pos), size_(size), seed_(seed), rng_(seed)
     {
     }
 
-    // Helper privato per parsing Vec2 dal JSON
-    namespace
+    Arena::Arena(const std::string& configPath, const std::optional<std::uint64_t> seed)
+        : Arena(RoomData::load(configPath), seed)
     {
-        Vec2<float> parseVec2(const nlohmann::json& j)
+    }
+
+    Arena::Arena(const RoomData& room, const std::optional<std::uint64_t> seed)
+        : pos_(room.pos), size_(room.size), tiles_(room.tiles)
+    {
+        // Il seme va fissato prima di spawnare gli attori che ne derivano uno
+        seed_ = seed.value_or(room.seed.value_or(DEFAULT_SEED));
+        rng_ = Rng(seed_);
+
+        // Load actors
+        loadActors(room);
+        loadEnemies(room);
+        loadDoors(room);
+        loadNPCs(room);
+
+        // La geometria della stanza è completa: indicizzala una volta sola
+        bakeStaticIndex();
+
+        // Il renderer compone la stanza da zero: gli spawn del caricamento non sono cambiamenti
+        dirtyRegions_.clear();
+    }
+
+    void Arena::loadActors(const RoomData& room)
+    {
+        for (const auto& [pos, size] : room.blocks)
         {
-            return Vec2{
-                j.at("x").get<float>(),
-                j.at("y").get<float>()
-            };
+            emplace<Actor>(pos, size);
         }
+    }
 
-        Vec2<float> parseSize(const nlohmann::json& j)
+    void Arena::loadEnemies(const RoomData& room)
+    {
+        for (const auto& [type, pos] : room.enemies)
         {
-            return Vec2{
-                j.at("width").get<float>(),
-                j.at("height").get<float>()
-            };
+            if (type == "zol")
+            {
+                emplace<Zol>(pos, rng_.next64());
+            }
+            // Qui puoi aggiungere altri tipi di nemici in futuro:
+            // else if (type == "moblin") { emplace<Moblin>(pos, config); }
         }
     }
 
-    Arena::Arena(const std::string& configPath)
+    void Arena::loadDoors(const RoomData& room)
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
+        for (const auto& door : room.doors)
         {
-            throw std::runtime_error("Could not open config file: " + configPath);
+            emplace<Door>(door.pos, door.size, door.spawn, door.destination, door.changeMusic);
         }
+    }
 
-        nlohmann::json j;
-        f >> j;
+    void Arena::loadNPCs(const RoomData& room)
+    {
+        for (const auto& npc : room.npcs)
+        {
+            emplace<NPC>(npc.pos, npc.size, npc.sprite, npc.dialogue, npc.name);
+        }
+    }
 
-        const auto& arenaJson = j.at("arena");
+    // Resto dei metodi invariati...
+    const Vec2<float>& Arena::pos() const { return pos_; }
+    const Vec2<float>& Arena::size() const { return size_; }
+    KeyMask Arena::prevInputs() const { return prevInputs_; }
+    KeyMask Arena::currInputs() const { return currInputs_; }
+    const TileMap& Arena::tiles() const { return tiles_; }
+    std::span<const Arena::Region> Arena::dirtyRegions() const { return dirtyRegions_; }
+    void Arena::clearDirtyRegions() { dirtyRegions_.clear(); }
 
-        // Parse arena properties
-        pos_ = parseVec2(arenaJson.at("pos"));
-        size_ = parseSize(arenaJson.at("size"));
+    void Arena::setTile(const int column, const int row, const std::uint16_t type)
+    {
+        tiles_.set(column, row, type);
+        invalidate(tiles_.cellPos(column, row), {tiles_.tileSize, tiles_.tileSize});
+    }
 
-        // Load actors
-        loadActors(arenaJson);
-        loadEnemies(arenaJson);
-        loadDoors(arenaJson);
-        loadNPCs(arenaJson);
+    void Arena::invalidate(const Vec2<float> pos, const Vec2<float> size)
+    {
+        dirtyRegions_.push_back({pos, size});
     }
+    std::span<const ActorPtr> Arena::actors() const { return actors_.items(); }
+    const TransformStore& Arena::transforms() const { return transforms_; }
 
-    void Arena::loadActors(const nlohmann::json& arenaJson)
+    const std::vector<Actor*>& Arena::actorsOf(const ActorKind kind) const
     {
-        if (!arenaJson.contains("actors")) return;
+        return kinds_[kindIndex(kind)];
+    }
 
-        for (const auto& actorJson : arenaJson.at("actors"))
-        {
-            Vec2<float> pos = parseVec2(actorJson.at("pos"));
-            Vec2<float> size = parseSize(actorJson.at("size"));
+    std::span<const Collision> Arena::collisions(const ActorHandle handle) const
+    {
+        if (!actors_.get(handle)) return {};
+        return collisions_[handle.index];
+    }
 
-            spawn(std::make_unique<Actor>(pos, size));
-        }
+    Actor* Arena::get(const ActorHandle handle) const
+    {
+        const auto* actor = actors_.get(handle);
+        return actor ? actor->get() : nullptr;
+    }
+
+    std::uint64_t Arena::seed() const
+    {
+        return seed_;
     }
 
-    void Arena::loadEnemies(const nlohmann::json& arenaJson)
+    Rng& Arena::rng()
     {
-        if (!arenaJson.contains("enemies")) return;
+        return rng_;
+    }
 
-        for (const auto& enemyJson : arenaJson.at("enemies"))
+    std::uint64_t Arena::stateHash() const
+    {
+        // FNV-1a sui bit esatti dei float: qualsiasi differenza cambia l'hash
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        const auto mix = [&hash](const std::uint32_t value)
         {
-            auto type = enemyJson.at("type").get<std::string>();
-            Vec2<float> pos = parseVec2(enemyJson.at("pos"));
-
-            if (type == "zol")
+            for (int i = 0; i < 4; ++i)
             {
-                spawn(std::make_unique<Zol>(pos));
+                hash ^= value >> (8 * i) & 0xff;
+                hash *= 0x100000001b3ULL;
             }
-            // Qui puoi aggiungere altri tipi di nemici in futuro:
-            // else if (type == "moblin") { spawn(std::make_unique<Moblin>(pos, config)); }
+        };
+
+        const auto actors = actors_.items();
+        for (std::size_t i = 0; i < actors.size(); ++i)
+        {
+            mix(actors[i]->kind());
+            mix(std::bit_cast<std::uint32_t>(transforms_.x()[i]));
+            mix(std::bit_cast<std::uint32_t>(transforms_.y()[i]));
+            if (const auto* fighter = actors[i]->as<Fighter>())
+                mix(std::bit_cast<std::uint32_t>(fighter->hp()));
         }
+        return hash;
     }
 
-    void Arena::loadDoors(const nlohmann::json& arenaJson)
+    void Arena::spawn(ActorPtr actor)
     {
-        if (!arenaJson.contains("doors")) return;
+        if (!actor) return;
 
-        for (const auto& doorJson : arenaJson.at("doors"))
+        if (ticking_)
         {
-            Vec2<float> pos = parseVec2(doorJson.at("pos"));
-            Vec2<float> size = parseSize(doorJson.at("size"));
-            Vec2<float> spawnPos = parseVec2(doorJson.at("spawn"));
-            bool changeMusic = doorJson.at("changeMusic").get<bool>();
-            auto destination = doorJson.at("destination").get<std::string>();
-
-            spawn(std::make_unique<Door>(pos, size, spawnPos, destination, changeMusic));
+            pendingSpawns_.push_back(std::move(actor));
+            return;
         }
+        insert(std::move(actor));
+    }
+
+    void Arena::spawn(ActorPtr actor, const Vec2<float> pos)
+    {
+        if (!actor) return;
+
+        actor->spawnPos_ = pos;
+        spawn(std::move(actor));
     }
 
-    void Arena::loadNPCs(const nlohmann::json& arenaJson)
+    void Arena::insert(ActorPtr actor)
     {
-        if (!arenaJson.contains("NPCs")) return;
+        actor->setArena(this);
+        Actor* raw = actor.get();
+        raw->handle_ = actors_.insert(std::move(actor));
+        if (collisions_.size() < actors_.slotCount())
+            collisions_.resize(actors_.slotCount());
+
+        // Da qui la geometria vive nello store, in fondo come l'attore in actors_
+        raw->transform_ = transforms_.push(raw->spawnPos_, raw->spawnPos_, raw->spawnSize_, raw->spawnSpeed_);
+        raw->transforms_ = &transforms_;
 
-        for (const auto& npcJson : arenaJson.at("NPCs"))
+        for (std::size_t bit = 0; bit < ACTOR_KIND_COUNT; ++bit)
         {
-            Vec2<float> pos = parseVec2(npcJson.at("pos"));
-            Vec2<float> size = parseSize(npcJson.at("size"));
-            auto name = npcJson.at("name").get<std::string>();
-            auto sprite = npcJson.at("sprite").get<std::string>();
-            auto dialogue = npcJson.at("dialoguePath").get<std::string>();
+            if (raw->kind() & 1u << bit)
+                kinds_[bit].push_back(raw);
+        }
 
-            spawn(std::make_unique<NPC>(pos, size, sprite, dialogue, name));
+        if (raw->is(AK_MOVABLE))
+        {
+            grid_.insert(raw->handle_, nextSpawnOrder_++, raw->pos(), raw->size());
+        }
+        else
+        {
+            // Spawn statico dopo il caricamento: l'indice verrà ricotto alla prossima query
+            statics_.push_back({raw->handle_, nextSpawnOrder_++});
+            staticIndexDirty_ = true;
+            invalidate(raw->pos(), raw->size());
         }
     }
 
-    // Resto dei metodi invariati...
-    const Vec2<float>& Arena::pos() const { return pos_; }
-    const Vec2<float>& Arena::size() const { return size_; }
-    const std::vector<Key>& Arena::prevInputs() const { return prevInputs_; }
-    const std::vector<Key>& Arena::currInputs() const { return currInputs_; }
-    const std::vector<std::unique_ptr<Actor>>& Arena::actors() const { return actors_; }
+    void Arena::despawn(Actor* actor)
+    {
+        if (!actor || actor->arena_ != this || actor->pendingKill_) return;
+
+        actor->pendingKill_ = true;
+        pendingKills_.push_back(actor);
+        leaveBroadphase(actor);
+    }
 
-    const std::unordered_map<const Actor*, std::vector<Collision>>& Arena::collisions() const
+    void Arena::leaveBroadphase(const Actor* actor)
     {
-        return collisions_;
+        // Le query non restituiscono più l'attore, senza doverlo controllare candidato per candidato
+        if (actor->is(AK_MOVABLE))
+        {
+            grid_.remove(actor->handle_);
+        }
+        else if (std::erase_if(statics_, [actor](const SpatialGrid::Entry& e) { return e.handle == actor->handle_; }) > 0)
+        {
+            staticIndexDirty_ = true;
+        }
     }
 
-    void Arena::spawn(std::unique_ptr<Actor> actor)
+    std::unique_ptr<Actor> Arena::kill(Actor* actor)
     {
-        if (!actor) return;
+        if (ticking_)
+        {
+            throw std::logic_error("Arena::kill called during tick, use despawn");
+        }
+        if (!actor || actor->pendingKill_) return nullptr;
 
-        actor->setArena(this);
-        if (dynamic_cast<Movable*>(actor.get()))
+        auto* owned = actors_.get(actor->handle_);
+        if (!owned || owned->get() != actor) return nullptr;
+        if (owned->get_deleter().resource)
         {
-            collisions_[actor.get()] = {};
+            throw std::logic_error("Arena::kill on an actor living in the arena's memory, spawn it with make_unique");
         }
-        actors_.push_back(std::move(actor));
+
+        // La geometria torna nell'attore, che da qui non ha più uno slot nello store
+        actor->spawnPos_ = actor->pos();
+        actor->spawnSize_ = actor->size();
+        actor->spawnSpeed_ = actor->speed();
+
+        // Stessa rimozione di despawn, ma l'attore viene sottratto prima della distruzione
+        std::unique_ptr<Actor> extracted(owned->release());
+        extracted->pendingKill_ = true;
+        pendingKills_.push_back(actor);
+        leaveBroadphase(actor);
+        removePendingKills();
+
+        extracted->transforms_ = nullptr;
+        extracted->pendingKill_ = false;
+        extracted->handle_ = {};
+        extracted->setArena(nullptr);
+        return extracted;
     }
 
-    std::unique_ptr<Actor> Arena::kill(Actor* actor)
+    void Arena::flushPending()
     {
-        if (!actor) return nullptr;
+        // Prima gli spawn: un attore spawnato e rimosso nello stesso tick esce pulito
+        for (auto& actor : pendingSpawns_)
+            insert(std::move(actor));
+        pendingSpawns_.clear();
 
-        const auto it = std::ranges::find_if(actors_,
-                                             [actor](const auto& a) { return a.get() == actor; });
+        if (!pendingKills_.empty())
+            removePendingKills();
+    }
+
+    void Arena::removePendingKills()
+    {
+        const auto dead = [](const Actor* actor) { return actor->pendingKill_; };
 
-        if (it != actors_.end())
+        // Griglia e indice statico li hanno già lasciati (leaveBroadphase)
+        for (const Actor* actor : pendingKills_)
         {
-            collisions_.erase(actor);
-            std::unique_ptr<Actor> extracted = std::move(*it);
-            actors_.erase(it);
-            return extracted;
+            collisions_[actor->handle_.index].clear(); // Lo slot verrà riusato
+            if (!actor->is(AK_MOVABLE))
+                invalidate(actor->pos(), actor->size());
         }
 
-        return nullptr;
+        // Una passata per lista, qualunque sia il numero di morti; l'ordine di spawn resta intatto
+        for (auto& list : kinds_)
+            std::erase_if(list, dead);
+
+        // Lo store si compatta con lo stesso criterio di actors_, così i due restano paralleli
+        const auto items = actors_.items();
+        const auto removed = [&](const ActorPtr& a) { return !a || dead(a.get()); };
+        transforms_.eraseIf([&](const std::size_t i) { return removed(items[i]); });
+
+        // Ultimo passo: qui gli attori vengono distrutti e i loro handle scadono.
+        // Le collisioni già registrate che li nominano restano, ma Arena::get
+        // restituisce nullptr per quegli handle.
+        actors_.eraseIf(removed);
+        pendingKills_.clear();
+
+        // Gli attori dopo il primo rimosso sono scalati verso l'inizio degli array
+        const auto survivors = actors_.items();
+        for (std::size_t i = 0; i < survivors.size(); ++i)
+            survivors[i]->transform_ = static_cast<std::uint32_t>(i);
     }
 
-    void Arena::tick(const std::vector<Key>& keys)
+    void Arena::tick(const KeyMask keys)
     {
         prevInputs_ = std::exchange(currInputs_, keys);
+        pressed_ = currInputs_ & ~prevInputs_;
+        released_ = prevInputs_ & ~currInputs_;
 
-        for (const auto& act : actors_)
+        // Rimozioni chieste fuori dal tick
+        flushPending();
+
+        // Posizioni di partenza per l'interpolazione: una copia lineare per tutti
+        transforms_.storePrevPositions();
+
+        // Solo i Movable, in ordine di spawn: nessun dynamic_cast nel frame.
+        // Spawn e rimozioni sono differiti, quindi la lista non cambia durante il ciclo.
+        ticking_ = true;
+        for (Actor* act : kinds_[kindIndex(AK_MOVABLE)])
         {
-            if (auto* movable = dynamic_cast<Movable*>(act.get()))
-            {
-                movable->move();
-                detectCollisionsFor(act.get());
-                handleCollisionsFor(act.get());
-
-                if (const auto* fighter = dynamic_cast<Fighter*>(act.get()))
-                {
-                    if (!fighter->isAlive())
-                    {
-                        kill(act.get());
-                    }
-                }
-            }
+            if (act->pendingKill_) continue;
+
+            act->asMovable()->move();
+            detectCollisionsFor(act);
+            handleCollisionsFor(act);
+            resolveTilesFor(act);
+            grid_.update(act->handle_, transforms_.pos(act->transform_), transforms_.size(act->transform_));
+
+            if (act->is(AK_FIGHTER) && !static_cast<const Fighter*>(act)->isAlive())
+                despawn(act);
         }
+        ticking_ = false;
+
+        flushPending();
+    }
+
+    void Arena::bakeStaticIndex()
+    {
+        staticBoxes_.clear();
+        for (const auto& entry : statics_)
+        {
+            const std::uint32_t i = actors_.denseIndex(entry.handle);
+            staticBoxes_.push(transforms_.pos(i), transforms_.size(i));
+        }
+        staticIndex_.build(statics_, staticBoxes_);
+        staticIndexDirty_ = false;
     }
 
     void Arena::detectCollisionsFor(const Actor* actor)
     {
-        auto& collisions = collisions_.at(actor);
+        auto& collisions = collisions_[actor->handle_.index];
         collisions.clear();
 
-        for (auto& other : actors_)
+        // Spawn o rimozioni di statici dall'ultima query
+        if (staticIndexDirty_)
+            bakeStaticIndex();
+
+        const Vec2<float> pos = transforms_.pos(actor->transform_);
+        const Vec2<float> size = transforms_.size(actor->transform_);
+
+        // Entrambe le query restituiscono i candidati in ordine di spawn:
+        // fonderle ricostruisce l'ordine di actors_
+        staticIndex_.query(pos, size, staticCandidates_);
+        grid_.query(pos, size, dynamicCandidates_);
+
+        candidates_.clear();
+        std::ranges::merge(staticCandidates_, dynamicCandidates_, std::back_inserter(candidates_), {},
+                           &SpatialGrid::Entry::order, &SpatialGrid::Entry::order);
+
+        // Gli attori in attesa di rimozione hanno già lasciato la broadphase: resta da togliere l'attore stesso
+        std::erase_if(candidates_, [actor](const SpatialGrid::Entry& entry) { return entry.handle == actor->handle_; });
+        if (candidates_.empty()) return;
+
+        // Stesso risultato di checkCollision su ogni candidato, ma 4/8 alla volta.
+        // I rettangoli vengono dallo store: nessun salto negli oggetti Actor.
+        candidateBoxes_.clear();
+        for (const auto& entry : candidates_)
         {
-            if (actor == other.get()) continue;
+            const std::uint32_t i = actors_.denseIndex(entry.handle);
+            candidateBoxes_.push(transforms_.pos(i), transforms_.size(i));
+        }
+        candidateDirections_.resize(candidates_.size());
+        candidateHits_.resize((candidates_.size() + 63) / 64);
 
-            if (const auto coll = actor->checkCollision(other.get()); coll != D_NONE)
-            {
-                collisions.emplace_back(other.get(), coll);
-            }
+        if (overlapBatch(pos, size, candidateBoxes_, candidateHits_.data(), candidateDirections_.data()) == 0)
+            return;
+
+        for (std::size_t i = 0; i < candidates_.size(); ++i)
+        {
+            if (candidateHits_[i / 64] >> (i % 64) & 1)
+                collisions.emplace_back(candidates_[i].handle, candidateDirections_[i]);
         }
     }
 
     void Arena::handleCollisionsFor(Actor* actor) const
     {
-        for (const auto& collision : collisions_.at(actor))
+        for (const auto& collision : collisions_[actor->handle_.index])
         {
             actor->handleCollision(collision);
         }
     }
 
-    bool Arena::hasKey(const std::vector<Key>& keys, const Key key)
+    void Arena::resolveTilesFor(Actor* actor) const
     {
-        return std::ranges::find(keys, key) != keys.end();
+        if (tiles_.empty()) return;
+
+        // Lookup diretto nella griglia: solo le celle sotto l'attore, qualunque sia il numero di muri.
+        // I muri vengono per ultimi, così nessuna spinta tra attori lascia qualcuno dentro un muro.
+        const auto cells = tiles_.range(actor->pos(), actor->size());
+        for (int row = cells.firstRow; row <= cells.lastRow; ++row)
+        {
+            for (int column = cells.firstColumn; column <= cells.lastColumn; ++column)
+            {
+                if (!tiles_.solid(column, row)) continue;
+
+                // La posizione va riletta: la cella precedente può aver già spinto fuori l'attore
+                const Direction direction = tiles_.collision(column, row, actor->pos(), actor->size());
+                if (direction != D_NONE)
+                    actor->handleTileCollision(tiles_.cellPos(column, row), {tiles_.tileSize, tiles_.tileSize}, direction);
+            }
+        }
+    }
+
+    bool Arena::isKeyDown(const Key key) const
+    {
+        return (currInputs_ & keyBit(key)) != 0;
     }
 
     bool Arena::isKeyJustPressed(const Key key) const
     {
-        return hasKey(currInputs_, key) && !hasKey(prevInputs_, key);
+        return (pressed_ & keyBit(key)) != 0;
+    }
+
+    bool Arena::isKeyJustReleased(const Key key) const
+    {
+        return (released_ & keyBit(key)) != 0;
     }
 }
@@ -0,0 +1,210 @@
+#include "atlas.hpp"
+#include "animationHandler.hpp"
+#include "binaryIo.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <stdexcept>
+
+namespace lulu
+{
+    namespace
+    {
+        // Formato (little-endian, vedi BinaryWriter):
+        //   "LLAT" u32 versione
+        //   u32 numero di pagine + per pagina: percorso, dimensioni (f32)
+        //   u32 numero di sprite + per sprite: percorso, u32 pagina, pos e dimensioni (f32)
+        constexpr char MAGIC[4] = {'L', 'L', 'A', 'T'};
+        constexpr std::uint32_t VERSION = 1;
+
+        // Byte minimi nel file di pagine e sprite (percorso vuoto: solo la lunghezza),
+        // per controllare i conteggi prima di allocare (getCount)
+        constexpr std::size_t PAGE_BYTES = sizeof(std::uint32_t) + 2 * sizeof(float);
+        constexpr std::size_t ENTRY_BYTES = 2 * sizeof(std::uint32_t) + 4 * sizeof(float);
+
+        void putVec2(BinaryWriter& out, const Vec2<float> value)
+        {
+            out.put(value.x);
+            out.put(value.y);
+        }
+
+        Vec2<float> getVec2(BinaryReader& in)
+        {
+            const float x = in.get<float>();
+            return {x, in.get<float>()};
+        }
+    }
+
+    Atlas Atlas::pack(std::vector<std::string> sprites, const std::string& pagePrefix,
+                      const int pageSize, const int padding)
+    {
+        std::ranges::sort(sprites);
+        const auto [first, last] = std::ranges::unique(sprites);
+        sprites.erase(first, last);
+
+        // Le sprite non leggibili restano fuori: il renderer proverà a caricarle dal file
+        std::vector<std::string> readable;
+        std::vector<Vec2<float>> sizes;
+        for (auto& sprite : sprites)
+        {
+            const auto size = AnimationHandler::getSpriteDimension(sprite);
+            if (!size) continue;
+            if (size->x > static_cast<float>(pageSize) || size->y > static_cast<float>(pageSize))
+            {
+                throw std::runtime_error("Sprite larger than an atlas page: " + sprite);
+            }
+            readable.push_back(std::move(sprite));
+            sizes.push_back(*size);
+        }
+        sprites = std::move(readable);
+
+        // Le più alte per prime: le righe ("shelf") sprecano meno spazio in verticale
+        std::vector<std::size_t> order(sprites.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&](const std::size_t a, const std::size_t b)
+        {
+            if (sizes[a].y != sizes[b].y) return sizes[a].y > sizes[b].y;
+            return sizes[a].x > sizes[b].x;
+        });
+
+        Atlas atlas;
+        const auto limit = static_cast<float>(pageSize);
+        const auto gap = static_cast<float>(padding);
+        Vec2<float> cursor{};
+        float shelfHeight = 0.0f;
+
+        const auto newPage = [&]
+        {
+            atlas.pages_.push_back({pagePrefix + std::to_string(atlas.pages_.size()) + ".png", {}});
+            cursor = {};
+            shelfHeight = 0.0f;
+        };
+        newPage();
+
+        for (const std::size_t i : order)
+        {
+            const Vec2<float> size = sizes[i];
+            if (cursor.x + size.x > limit)
+            {
+                cursor = {0.0f, cursor.y + shelfHeight + gap};
+                shelfHeight = 0.0f;
+            }
+            if (cursor.y + size.y > limit)
+                newPage();
+
+            Page& page = atlas.pages_.back();
+            page.size = {std::max(page.size.x, cursor.x + size.x), std::max(page.size.y, cursor.y + size.y)};
+
+            atlas.entries_.push_back({
+                sprites[i],
+                {static_cast<std::uint32_t>(atlas.pages_.size() - 1), cursor, size}
+            });
+            cursor.x += size.x + gap;
+            shelfHeight = std::max(shelfHeight, size.y);
+        }
+
+        if (atlas.entries_.empty())
+            atlas.pages_.clear();
+
+        atlas.index();
+        return atlas;
+    }
+
+    Atlas Atlas::load(const std::string& path)
+    {
+        namespace fs = std::filesystem;
+
+        BinaryReader in(path);
+        in.expectHeader(MAGIC, VERSION);
+
+        Atlas atlas;
+        atlas.pages_.resize(in.getCount(PAGE_BYTES));
+        for (auto& [image, size] : atlas.pages_)
+        {
+            image = in.getString();
+            size = getVec2(in);
+        }
+
+        std::error_code error;
+        const auto atlasTime = fs::last_write_time(path, error);
+
+        const std::size_t count = in.getCount(ENTRY_BYTES);
+        atlas.entries_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Entry entry;
+            entry.sprite = in.getString();
+            entry.region.page = in.get<std::uint32_t>();
+            entry.region.pos = getVec2(in);
+            entry.region.size = getVec2(in);
+
+            if (entry.region.page >= atlas.pages_.size())
+            {
+                throw std::runtime_error("Invalid atlas page in: " + path);
+            }
+
+            // Sprite modificata dopo l'impacchettamento: la pagina ha ancora quella vecchia
+            const auto spriteTime = fs::last_write_time(entry.sprite, error);
+            if (!error && spriteTime > atlasTime) continue;
+
+            atlas.entries_.push_back(std::move(entry));
+        }
+
+        in.expectEnd();
+        atlas.index();
+        return atlas;
+    }
+
+    void Atlas::writeBinary(const std::string& path) const
+    {
+        BinaryWriter out;
+        out.putRaw(MAGIC);
+        out.put(VERSION);
+
+        out.put(static_cast<std::uint32_t>(pages_.size()));
+        for (const auto& [image, size] : pages_)
+        {
+            out.put(image);
+            putVec2(out, size);
+        }
+
+        out.put(static_cast<std::uint32_t>(entries_.size()));
+        for (const auto& [sprite, region] : entries_)
+        {
+            out.put(sprite);
+            out.put(region.page);
+            putVec2(out, region.pos);
+            putVec2(out, region.size);
+        }
+
+        out.save(path);
+    }
+
+    void Atlas::index()
+    {
+        regions_.clear();
+        for (const auto& [sprite, region] : entries_)
+        {
+            const SpriteId id = SpriteRegistry::intern(sprite);
+            if (id >= regions_.size())
+                regions_.resize(id + 1);
+            regions_[id] = region;
+        }
+    }
+
+    const AtlasRegion* Atlas::region(const SpriteId sprite) const
+    {
+        if (sprite >= regions_.size() || !regions_[sprite]) return nullptr;
+        return &*regions_[sprite];
+    }
+
+    std::span<const Atlas::Page> Atlas::pages() const
+    {
+        return pages_;
+    }
+
+    std::span<const Atlas::Entry> Atlas::entries() const
+    {
+        return entries_;
+    }
+} // namespace lulu
@@ -0,0 +1,94 @@
+#include "backgroundChunks.hpp"
+#include "binaryIo.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lulu
+{
+    namespace
+    {
+        // Formato (little-endian, vedi BinaryWriter):
+        //   "LLBG" u32 versione
+        //   dimensioni dell'immagine (f32), u32 lato del chunk, cartella dei chunk
+        constexpr char MAGIC[4] = {'L', 'L', 'B', 'G'};
+        constexpr std::uint32_t VERSION = 1;
+    }
+
+    std::optional<BackgroundChunks> BackgroundChunks::find(const std::string& background)
+    {
+        if (const auto table = freshCompiled(background, EXTENSION))
+            return load(*table);
+        return std::nullopt;
+    }
+
+    BackgroundChunks BackgroundChunks::load(const std::string& path)
+    {
+        BinaryReader in(path);
+        in.expectHeader(MAGIC, VERSION);
+
+        BackgroundChunks chunks;
+        const float width = in.get<float>();
+        chunks.size = {width, in.get<float>()};
+        chunks.chunkSize = in.get<std::uint32_t>();
+        chunks.directory = in.getString();
+        in.expectEnd();
+
+        if (chunks.chunkSize == 0 || chunks.size.x <= 0 || chunks.size.y <= 0)
+        {
+            throw std::runtime_error("Invalid background chunks: " + path);
+        }
+        return chunks;
+    }
+
+    void BackgroundChunks::writeBinary(const std::string& path) const
+    {
+        BinaryWriter out;
+        out.putRaw(MAGIC);
+        out.put(VERSION);
+        out.put(size.x);
+        out.put(size.y);
+        out.put(chunkSize);
+        out.put(directory);
+        out.save(path);
+    }
+
+    int BackgroundChunks::columns() const
+    {
+        return static_cast<int>(std::ceil(size.x / static_cast<float>(chunkSize)));
+    }
+
+    int BackgroundChunks::rows() const
+    {
+        return static_cast<int>(std::ceil(size.y / static_cast<float>(chunkSize)));
+    }
+
+    std::size_t BackgroundChunks::index(const int column, const int row) const
+    {
+        return static_cast<std::size_t>(row) * static_cast<std::size_t>(columns()) + static_cast<std::size_t>(column);
+    }
+
+    std::string BackgroundChunks::path(const int column, const int row) const
+    {
+        return directory + "/" + std::to_string(column) + "_" + std::to_string(row) + ".png";
+    }
+
+    Vec2<float> BackgroundChunks::origin(const int column, const int row) const
+    {
+        return Vec2{column, row}.convert<float>() * static_cast<float>(chunkSize);
+    }
+
+    BackgroundChunks::Range BackgroundChunks::range(const Vec2<float>& pos, const Vec2<float>& rectSize,
+                                                    const int margin) const
+    {
+        const auto side = static_cast<float>(chunkSize);
+        const auto cell = [&](const float coordinate) { return static_cast<int>(std::floor(coordinate / side)); };
+
+        // Il bordo destro/inferiore è escluso: un rettangolo che finisce su un bordo non tocca il chunk dopo
+        return {
+            std::max(cell(pos.x) - margin, 0),
+            std::max(cell(pos.y) - margin, 0),
+            std::min(cell(std::nextafter(pos.x + rectSize.x, pos.x)) + margin, columns() - 1),
+            std::min(cell(std::nextafter(pos.y + rectSize.y, pos.y)) + margin, rows() - 1)
+        };
+    }
+} // namespace lulu
@@ -0,0 +1,116 @@
+#include "binaryIo.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace lulu
+{
+    void BinaryWriter::put(const std::string& value)
+    {
+        put(static_cast<std::uint32_t>(value.size()));
+        putRaw(value);
+    }
+
+    void BinaryWriter::putRaw(const std::span<const char> bytes)
+    {
+        bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+    }
+
+    void BinaryWriter::save(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open() || !out.write(bytes_.data(), static_cast<std::streamsize>(bytes_.size())))
+        {
+            throw std::runtime_error("Could not write file: " + path);
+        }
+    }
+
+    BinaryReader::BinaryReader(const std::string& path) : path_(path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+
+        bytes_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        if (!in.read(bytes_.data(), static_cast<std::streamsize>(bytes_.size())))
+        {
+            throw std::runtime_error("Could not read file: " + path);
+        }
+    }
+
+    const char* BinaryReader::take(const std::size_t count)
+    {
+        if (count > remaining())
+        {
+            throw std::runtime_error("Truncated file: " + path_);
+        }
+        const char* data = bytes_.data() + offset_;
+        offset_ += count;
+        return data;
+    }
+
+    std::string BinaryReader::getString()
+    {
+        const auto size = get<std::uint32_t>();
+        return {take(size), size};
+    }
+
+    std::size_t BinaryReader::getCount(const std::size_t elementSize)
+    {
+        const std::size_t count = get<std::uint32_t>();
+        if (elementSize != 0 && count > remaining() / elementSize)
+        {
+            throw std::runtime_error("Truncated file: " + path_);
+        }
+        return count;
+    }
+
+    std::size_t BinaryReader::remaining() const
+    {
+        return bytes_.size() - offset_;
+    }
+
+    void BinaryReader::expectHeader(const std::span<const char> magic, const std::uint32_t version)
+    {
+        if (!std::ranges::equal(std::span(take(magic.size()), magic.size()), magic))
+        {
+            throw std::runtime_error("Unexpected file format: " + path_);
+        }
+        if (get<std::uint32_t>() != version)
+        {
+            throw std::runtime_error("Unsupported file version: " + path_);
+        }
+    }
+
+    void BinaryReader::expectEnd() const
+    {
+        if (offset_ != bytes_.size())
+        {
+            throw std::runtime_error("Trailing data in file: " + path_);
+        }
+    }
+
+    std::string compiledPath(const std::string& sourcePath, const std::string_view extension)
+    {
+        return std::filesystem::path(sourcePath).replace_extension(extension).string();
+    }
+
+    std::optional<std::string> freshCompiled(const std::string& sourcePath, const std::string_view extension)
+    {
+        namespace fs = std::filesystem;
+
+        std::string compiled = compiledPath(sourcePath, extension);
+        std::error_code error;
+        const auto compiledTime = fs::last_write_time(compiled, error);
+        if (error) return std::nullopt;
+
+        // Senza sorgente (es: build di release con i soli asset compilati) vale il binario
+        const auto sourceTime = fs::last_write_time(sourcePath, error);
+        if (!error && sourceTime > compiledTime) return std::nullopt;
+
+        return compiled;
+    }
+} // namespace lulu
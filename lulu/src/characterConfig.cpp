@@ -0,0 +1,234 @@
+#include "characterConfig.hpp"
+#include "animationHandler.hpp"
+#include "binaryIo.hpp"
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+
+namespace lulu
+{
+    namespace
+    {
+        // Formato (little-endian, vedi BinaryWriter):
+        //   "LLCH" u32 versione
+        //   sprite, size, speed, enableAnimation, hp, damage
+        //   per ogni State e Direction: u32 numero di frame, poi per frame sprite + dimensioni
+        constexpr char MAGIC[4] = {'L', 'L', 'C', 'H'};
+        constexpr std::uint32_t VERSION = 1;
+
+        // Byte minimi di un frame nel file: sprite (almeno la lunghezza) e dimensioni
+        constexpr std::size_t FRAME_BYTES = sizeof(std::uint32_t) + 2 * sizeof(float);
+
+        std::atomic<std::size_t> loads{0};
+
+        // Le dimensioni di ogni frame vengono dal PNG; se non leggibile lo si segnala e si usa la size dell'attore
+        Vec2<float> spriteSize(const std::string& path, const Vec2<float>& fallbackSize)
+        {
+            if (const auto size = AnimationHandler::getSpriteDimension(path))
+                return *size;
+
+            std::cerr << "warning: could not read sprite " << path << ", using the actor size\n";
+            return fallbackSize;
+        }
+
+        std::vector<AnimationFrame> parseFrames(const nlohmann::json& j, const Vec2<float>& fallbackSize)
+        {
+            std::vector<AnimationFrame> frames;
+            for (const auto& sprite : j)
+            {
+                const auto path = sprite.get<std::string>();
+                frames.push_back({SpriteRegistry::intern(path), spriteSize(path, fallbackSize)});
+            }
+            return frames;
+        }
+
+        // Compila le quattro sequenze cardinali di una sezione nella tabella, per ogni stato indicato
+        void compileAnimation(AnimationTable& table, const nlohmann::json& j, const Vec2<float>& fallbackSize,
+                              const std::initializer_list<State> states)
+        {
+            std::vector<AnimationFrame> up, down, left, right;
+            if (j.contains("up")) up = parseFrames(j["up"], fallbackSize);
+            if (j.contains("down")) down = parseFrames(j["down"], fallbackSize);
+            if (j.contains("left")) left = parseFrames(j["left"], fallbackSize);
+            if (j.contains("right")) right = parseFrames(j["right"], fallbackSize);
+
+            for (const State state : states)
+            {
+                table.set(state, D_UP, up);
+                table.set(state, D_UPLEFT, up);
+                table.set(state, D_UPRIGHT, up);
+                table.set(state, D_DOWN, down);
+                table.set(state, D_DOWNLEFT, down);
+                table.set(state, D_DOWNRIGHT, down);
+                table.set(state, D_LEFT, left);
+                table.set(state, D_RIGHT, right);
+            }
+        }
+    }
+
+    CharacterConfig CharacterConfig::parseJson(const std::string& configPath)
+    {
+        loads.fetch_add(1, std::memory_order_relaxed);
+
+        std::ifstream f(configPath);
+        if (!f.is_open())
+        {
+            throw std::runtime_error("Could not open config file: " + configPath);
+        }
+
+        nlohmann::json j;
+        f >> j;
+
+        CharacterConfig config;
+
+        // Sezione "actor" (obbligatoria)
+        const auto& actorJson = j.at("actor");
+        const auto sprite = actorJson.at("sprite").get<std::string>();
+        config.sprite = SpriteRegistry::intern(sprite);
+        config.size = Vec2{
+            actorJson.at("size").at("width").get<float>(),
+            actorJson.at("size").at("height").get<float>()
+        };
+
+        // Sezione "movable"
+        if (j.contains("movable"))
+        {
+            const auto& movableJson = j["movable"];
+
+            if (movableJson.contains("speed"))
+            {
+                const auto& speedJson = movableJson["speed"];
+                config.speed = Vec2{speedJson["x"].get<float>(), speedJson["y"].get<float>()};
+            }
+
+            if (movableJson.contains("enableAnimation"))
+            {
+                config.enableAnimation = movableJson["enableAnimation"].get<bool>();
+            }
+        }
+
+        // Sezione "fighter"
+        if (j.contains("fighter"))
+        {
+            const auto& fighterJson = j["fighter"];
+
+            if (fighterJson.contains("hp"))
+                config.hp = fighterJson["hp"].get<float>();
+
+            if (fighterJson.contains("damage"))
+                config.damage = fighterJson["damage"].get<float>();
+        }
+
+        // Sezione "animations"
+        if (j.contains("animations"))
+        {
+            const auto& animations = j["animations"];
+
+            if (animations.contains("movement"))
+                compileAnimation(config.animations, animations["movement"], config.size, {S_MOVING, S_STILL});
+
+            if (animations.contains("attack"))
+                compileAnimation(config.animations, animations["attack"], config.size, {S_ATTACK});
+        }
+
+        // La sprite iniziale non viene aperta: se è un frame, parseFrames l'ha già
+        // verificata; altrimenti (es: percorso sbagliato) lo si segnala qui
+        if (config.animations.frameCount() > 0 && !config.animations.contains(config.sprite))
+            std::cerr << "warning: actor sprite " << sprite << " is not one of the animation frames\n";
+
+        return config;
+    }
+
+    std::shared_ptr<const CharacterConfig> CharacterConfig::load(const std::string& configPath)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::shared_ptr<const CharacterConfig>> cache;
+
+        std::scoped_lock lock(mutex);
+        auto& config = cache[configPath];
+        if (!config)
+        {
+            const auto compiled = freshCompiled(configPath, COMPILED_EXTENSION);
+            config = std::make_shared<const CharacterConfig>(compiled ? readBinary(*compiled) : parseJson(configPath));
+        }
+        return config;
+    }
+
+    CharacterConfig CharacterConfig::readBinary(const std::string& path)
+    {
+        loads.fetch_add(1, std::memory_order_relaxed);
+
+        BinaryReader in(path);
+        in.expectHeader(MAGIC, VERSION);
+
+        CharacterConfig config;
+        config.sprite = SpriteRegistry::intern(in.getString());
+        config.size.x = in.get<float>();
+        config.size.y = in.get<float>();
+        config.speed.x = in.get<float>();
+        config.speed.y = in.get<float>();
+        config.enableAnimation = in.get<bool>();
+        config.hp = in.get<float>();
+        config.damage = in.get<float>();
+
+        std::vector<AnimationFrame> frames;
+        for (std::size_t state = 0; state < STATE_COUNT; ++state)
+        {
+            for (std::size_t direction = 0; direction < DIRECTION_COUNT; ++direction)
+            {
+                frames.resize(in.getCount(FRAME_BYTES));
+                for (auto& [sprite, size] : frames)
+                {
+                    sprite = SpriteRegistry::intern(in.getString());
+                    size.x = in.get<float>();
+                    size.y = in.get<float>();
+                }
+                config.animations.set(static_cast<State>(state), static_cast<Direction>(direction), frames);
+            }
+        }
+
+        in.expectEnd();
+        return config;
+    }
+
+    std::size_t CharacterConfig::loadCount()
+    {
+        return loads.load(std::memory_order_relaxed);
+    }
+
+    void CharacterConfig::writeBinary(const std::string& path) const
+    {
+        BinaryWriter out;
+        out.putRaw(MAGIC);
+        out.put(VERSION);
+
+        out.put(SpriteRegistry::path(sprite));
+        out.put(size.x);
+        out.put(size.y);
+        out.put(speed.x);
+        out.put(speed.y);
+        out.put(enableAnimation);
+        out.put(hp);
+        out.put(damage);
+
+        for (std::size_t state = 0; state < STATE_COUNT; ++state)
+        {
+            for (std::size_t direction = 0; direction < DIRECTION_COUNT; ++direction)
+            {
+                const auto clip = animations.clip(static_cast<State>(state), static_cast<Direction>(direction));
+                out.put(static_cast<std::uint32_t>(clip.size()));
+                for (const auto& [frameSprite, frameSize] : clip)
+                {
+                    out.put(SpriteRegistry::path(frameSprite));
+                    out.put(frameSize.x);
+                    out.put(frameSize.y);
+                }
+            }
+        }
+
+        out.save(path);
+    }
+} // namespace lulu
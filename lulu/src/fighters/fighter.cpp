@@ -1,70 +1,53 @@
 #include "fighters/fighter.hpp"
 
-#include <nlohmann/json.hpp>
-
 namespace lulu
 {
     Fighter::Fighter(const Vec2<float> position, const Vec2<float> size, const Vec2<float> speed, const float hp,
                      const float damage, const std::string& sprite)
-        : Actor(position, size, sprite), Movable(speed, true), hp_(hp), damage_(damage)
+        : Actor(position, size, sprite, speed), Movable(true), hp_(hp), damage_(damage)
     {
+        kind_ |= AK_MOVABLE | AK_FIGHTER;
     }
 
-    Fighter::Fighter(Vec2<float> pos, const std::string& configPath) : Actor(pos, configPath), Movable(configPath)
+    Fighter::Fighter(const Vec2<float> pos, std::shared_ptr<const CharacterConfig> config)
+        : Actor(pos, *config), Movable(*config), hp_(config->hp), damage_(config->damage), config_(std::move(config))
     {
-        std::ifstream f(configPath);
-        if (!f.is_open())
-        {
-            throw std::runtime_error("Could not open config file: " + configPath);
-        }
-
-        nlohmann::json j;
-        f >> j;
-
-        // Parsing sezione "fighter"
-        if (j.contains("fighter"))
-        {
-            const auto& fighterJson = j["fighter"];
-
-            if (fighterJson.contains("hp"))
-            {
-                hp_ = fighterJson["hp"].get<float>();
-            }
-
-            if (fighterJson.contains("damage"))
-            {
-                damage_ = fighterJson["damage"].get<float>();
-            }
-        }
+        kind_ |= AK_MOVABLE | AK_FIGHTER;
     }
 
     void Fighter::recoil(const Direction collisionDirection)
     {
+        const Vec2<float> speed = this->speed();
         switch (collisionDirection)
         {
         case D_UP:
         case D_UPLEFT:
         case D_UPRIGHT:
-            pos_.y += speed_.y * 2;
+            translate({0, speed.y * 2});
             break;
 
         case D_DOWN:
         case D_DOWNLEFT:
         case D_DOWNRIGHT:
-            pos_.y -= speed_.y * 2;
+            translate({0, -speed.y * 2});
             break;
 
         case D_LEFT:
-            pos_.x += speed_.x * 2;
+            translate({speed.x * 2, 0});
             break;
         case D_RIGHT:
-            pos_.x -= speed_.x * 2;
+            translate({-speed.x * 2, 0});
             break;
         default:
             break;
         }
     }
 
+    Movable* Fighter::asMovable()
+    {
+        return this;
+    }
+
     void Fighter::takeDamage(const float damage)
     {
         hp_ -= damage;
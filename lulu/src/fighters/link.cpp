@@ -1,83 +1,18 @@
 #include "fighters/link.hpp"
 #include "arena.hpp"
-#include <fstream>
-#include <nlohmann/json.hpp>
 
 namespace lulu
 {
-    Link::Link(Vec2<float> pos, const std::string& configPath) : Fighter(pos, configPath)
+    Link::Link(const Vec2<float> pos, const std::string& configPath) : Link(pos, CharacterConfig::load(configPath))
     {
-        // Leggi il JSON
-        std::ifstream f(configPath);
-        nlohmann::json j;
-        f >> j;
-
-        // Parse dei dati base
-        const auto& actorData = j["actor"];
-        const auto& movableData = j["movable"];
-        const auto& fighterData = j["fighter"];
-
-        // Inizializza sprite base
-        sprite_ = actorData["sprite"];
-
-        // Inizializza size e salva come originale
-        size_ = Vec2{actorData["size"]["width"].get<float>(), actorData["size"]["height"].get<float>()};
-
-        // Inizializza velocità
-        speed_ = Vec2{movableData["speed"]["x"].get<float>(), movableData["speed"]["y"].get<float>()};
-
-        // Inizializza hp e damage
-        hp_ = fighterData["hp"].get<float>();
-        damage_ = fighterData["damage"].get<float>();
-
-        // Abilita animazioni
-        movement_.enabled_ = movableData["enableAnimation"].get<bool>();
-
-        const auto& animations = j["animations"];
-
-        // Setup animazioni movimento
-        const auto& movement = animations["movement"];
-        std::vector<std::string> up = movement["up"];
-        std::vector<std::string> down = movement["down"];
-        std::vector<std::string> left = movement["left"];
-        std::vector<std::string> right = movement["right"];
-
-        // Aggiungi animazioni movimento per tutte le direzioni
-        movement_.addAnimation(S_MOVING, D_UP, up);
-        movement_.addAnimation(S_MOVING, D_UPLEFT, up);
-        movement_.addAnimation(S_MOVING, D_UPRIGHT, up);
-        movement_.addAnimation(S_MOVING, D_DOWN, down);
-        movement_.addAnimation(S_MOVING, D_DOWNLEFT, down);
-        movement_.addAnimation(S_MOVING, D_DOWNRIGHT, down);
-        movement_.addAnimation(S_MOVING, D_LEFT, left);
-        movement_.addAnimation(S_MOVING, D_RIGHT, right);
-
-        // Aggiungi animazioni still (uguali a quelle di movimento)
-        movement_.addAnimation(S_STILL, D_UP, up);
-        movement_.addAnimation(S_STILL, D_UPLEFT, up);
-        movement_.addAnimation(S_STILL, D_UPRIGHT, up);
-        movement_.addAnimation(S_STILL, D_DOWN, down);
-        movement_.addAnimation(S_STILL, D_DOWNLEFT, down);
-        movement_.addAnimation(S_STILL, D_DOWNRIGHT, down);
-        movement_.addAnimation(S_STILL, D_LEFT, left);
-        movement_.addAnimation(S_STILL, D_RIGHT, right);
-
-        // Setup animazioni attacco
-        const auto& attack = animations["attack"];
-        std::vector<std::string> attackUp = attack["up"];
-        std::vector<std::string> attackDown = attack["down"];
-        std::vector<std::string> attackLeft = attack["left"];
-        std::vector<std::string> attackRight = attack["right"];
-
-        // Aggiungi animazioni attacco per tutte le direzioni
-        movement_.addAnimation(S_ATTACK, D_UP, attackUp);
-        movement_.addAnimation(S_ATTACK, D_UPLEFT, attackUp);
-        movement_.addAnimation(S_ATTACK, D_UPRIGHT, attackUp);
-        movement_.addAnimation(S_ATTACK, D_DOWN, attackDown);
-        movement_.addAnimation(S_ATTACK, D_DOWNLEFT, attackDown);
-        movement_.addAnimation(S_ATTACK, D_DOWNRIGHT, attackDown);
-        movement_.addAnimation(S_ATTACK, D_LEFT, attackLeft);
-        movement_.addAnimation(S_ATTACK, D_RIGHT, attackRight);
+    }
+
+    Link::Link(const Vec2<float> pos, std::shared_ptr<const CharacterConfig> config) : Fighter(pos, std::move(config))
+    {
+        kind_ |= AK_PLAYER;
+
+        // Le clip sono compilate una volta sola nel CharacterConfig e condivise
+        movement_.setTable(&config_->animations);
 
         // Inizializza animazione
         movement_.set(S_STILL, D_UP);
@@ -105,33 +40,14 @@ namespace lulu
 
     Direction Link::updatedDirection() const
     {
-        bool w = false, a = false, s = false, d = false;
+        constexpr KeyMask UP_KEYS = keyBit(K_W) | keyBit(K_UP);
+        constexpr KeyMask LEFT_KEYS = keyBit(K_A) | keyBit(K_LEFT);
+        constexpr KeyMask DOWN_KEYS = keyBit(K_S) | keyBit(K_DOWN);
+        constexpr KeyMask RIGHT_KEYS = keyBit(K_D) | keyBit(K_RIGHT);
 
         // Check which directional keys are currently pressed
-        for (const Key key : arena_->currInputs())
-        {
-            switch (key)
-            {
-            case K_W:
-            case K_UP:
-                w = true;
-                break;
-            case K_A:
-            case K_LEFT:
-                a = true;
-                break;
-            case K_S:
-            case K_DOWN:
-                s = true;
-                break;
-            case K_D:
-            case K_RIGHT:
-                d = true;
-                break;
-            default:
-                break;
-            }
-        }
+        const KeyMask keys = arena_->currInputs();
+        bool w = keys & UP_KEYS, a = keys & LEFT_KEYS, s = keys & DOWN_KEYS, d = keys & RIGHT_KEYS;
 
         // Resolve conflicting inputs (opposite directions cancel out)
         if (a && d)
@@ -163,21 +79,22 @@ namespace lulu
     Vec2<float> Link::calculateMovement(const Direction dir) const
     {
         Vec2<float> movement{};
-        const auto [x, y] = speed_.diagonal().value();
+        const Vec2<float> speed = this->speed();
+        const auto [x, y] = speed.diagonal().value();
 
         switch (dir)
         {
         case D_UP:
-            movement = {0, -speed_.y};
+            movement = {0, -speed.y};
             break;
         case D_DOWN:
-            movement = {0, speed_.y};
+            movement = {0, speed.y};
             break;
         case D_LEFT:
-            movement = {-speed_.x, 0};
+            movement = {-speed.x, 0};
             break;
         case D_RIGHT:
-            movement = {speed_.x, 0};
+            movement = {speed.x, 0};
             break;
         case D_UPLEFT:
             movement = {-x, -y};
@@ -208,13 +125,13 @@ namespace lulu
         case D_UPLEFT:
         case D_UPRIGHT:
             // Per attacchi verso l'alto, sposta Link verso l'alto
-            pos_.y -= sizeDifference.y;
+            translate({0, -sizeDifference.y});
             break;
 
         case D_LEFT:
         case D_DOWNLEFT:
             // Per attacchi verso sinistra, sposta Link verso sinistra
-            pos_.x -= sizeDifference.x;
+            translate({-sizeDifference.x, 0});
             break;
 
         // DOWN e RIGHT non richiedono aggiustamenti (sprite espande verso basso/destra)
@@ -240,14 +157,15 @@ namespace lulu
             return;
 
         // Avanza all'animazione successiva
-        sprite_ = movement_.nextSprite();
+        const AnimationFrame& frame = movement_.nextFrame();
+        sprite_ = frame.sprite;
 
-        // Aggiorna le dimensioni in base alla nuova sprite
-        const Vec2<float> oldSize = size_;
-        size_ = AnimationHandler::getSpriteDimension(sprite_).value();
+        // Aggiorna le dimensioni in base alla nuova sprite (già note, niente I/O)
+        const Vec2<float> oldSize = size();
+        setSize(frame.size);
 
         // Aggiusta la posizione se le dimensioni sono cambiate
-        const Vec2<float> sizeDiff = size_ - oldSize;
+        const Vec2<float> sizeDiff = frame.size - oldSize;
         adjustPositionForSize(sizeDiff);
     }
 
@@ -259,14 +177,15 @@ namespace lulu
 
         // Torna allo stato di movimento
         movement_.set(S_MOVING, movement_.currentDirection());
-        sprite_ = movement_.nextSprite();
+        const AnimationFrame& frame = movement_.nextFrame();
+        sprite_ = frame.sprite;
 
         // Ripristina le dimensioni originali
-        const Vec2<float> oldSize = size_;
-        size_ = AnimationHandler::getSpriteDimension(sprite_).value();
+        const Vec2<float> oldSize = size();
+        setSize(frame.size);
 
         // Aggiusta la posizione finale
-        const Vec2<float> sizeDiff = size_ - oldSize;
+        const Vec2<float> sizeDiff = frame.size - oldSize;
         adjustPositionForSize(sizeDiff);
     }
 
@@ -274,8 +193,9 @@ namespace lulu
     {
         // Durante l'attacco, Link ignora collisioni con oggetti statici
         // ma continua a collidere con entità mobili (altri Fighter)
-        Actor* other = collision.target;
-        auto* fighter = dynamic_cast<Fighter*>(other);
+        Actor* other = arena_->get(collision.target);
+        if (!other) return;
+        auto* fighter = other->as<Fighter>();
 
         if (fighter == nullptr)
         {
@@ -305,6 +225,14 @@ namespace lulu
         }
     }
 
+    void Link::handleTileCollision(const Vec2<float> tilePos, const Vec2<float> tileSize, const Direction direction)
+    {
+        if (isAttacking_)
+            return;
+
+        Actor::handleTileCollision(tilePos, tileSize, direction);
+    }
+
     void Link::move()
     {
         const State newState = updatedState();
@@ -322,7 +250,7 @@ namespace lulu
             // Gestione movimento
             if (newDirection != D_NONE)
             {
-                pos_ += calculateMovement(newDirection);
+                translate(calculateMovement(newDirection));
 
                 // Cambio direzione richiede reset animazione
                 if (movement_.currentDirection() != newDirection)
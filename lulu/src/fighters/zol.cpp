@@ -1,82 +1,29 @@
 #include "fighters/zol.hpp"
-#include <nlohmann/json.hpp>
-#include <random>
 
 namespace lulu {
-    Zol::Zol(Vec2<float> pos, const std::string& config) : Fighter(pos, config)
+    namespace
     {
-        // Leggi il JSON
-        std::ifstream f(config);
-        nlohmann::json j;
-        f >> j;
-
-        // Parse dei dati base
-        const auto& actorData = j["actor"];
-        const auto& movableData = j["movable"];
-        const auto& fighterData = j["fighter"];
-
-        // Inizializza sprite base
-        sprite_ = actorData["sprite"];
-
-        // Inizializza size e salva come originale
-        size_ = Vec2{actorData["size"]["width"].get<float>(), actorData["size"]["height"].get<float>()};
-
-        // Inizializza velocità
-        speed_ = Vec2{movableData["speed"]["x"].get<float>(), movableData["speed"]["y"].get<float>()};
-
-        // Inizializza hp e damage
-        hp_ = fighterData["hp"].get<float>();
-        damage_ = fighterData["damage"].get<float>();
-
-        // Abilita animazioni
-        movement_.enabled_ = movableData["enableAnimation"].get<bool>();
-
-        const auto& animations = j["animations"];
-
-        // Setup animazioni movimento
-        const auto& movement = animations["movement"];
-        std::vector<std::string> up = movement["up"];
-        std::vector<std::string> down = movement["down"];
-        std::vector<std::string> left = movement["left"];
-        std::vector<std::string> right = movement["right"];
-
-        // Aggiungi animazioni movimento per tutte le direzioni
-        movement_.addAnimation(S_MOVING, D_UP, up);
-        movement_.addAnimation(S_MOVING, D_UPLEFT, up);
-        movement_.addAnimation(S_MOVING, D_UPRIGHT, up);
-        movement_.addAnimation(S_MOVING, D_DOWN, down);
-        movement_.addAnimation(S_MOVING, D_DOWNLEFT, down);
-        movement_.addAnimation(S_MOVING, D_DOWNRIGHT, down);
-        movement_.addAnimation(S_MOVING, D_LEFT, left);
-        movement_.addAnimation(S_MOVING, D_RIGHT, right);
-
-        // Aggiungi animazioni still (uguali a quelle di movimento)
-        movement_.addAnimation(S_STILL, D_UP, up);
-        movement_.addAnimation(S_STILL, D_UPLEFT, up);
-        movement_.addAnimation(S_STILL, D_UPRIGHT, up);
-        movement_.addAnimation(S_STILL, D_DOWN, down);
-        movement_.addAnimation(S_STILL, D_DOWNLEFT, down);
-        movement_.addAnimation(S_STILL, D_DOWNRIGHT, down);
-        movement_.addAnimation(S_STILL, D_LEFT, left);
-        movement_.addAnimation(S_STILL, D_RIGHT, right);
+        // Direzioni tra cui lo Zol sceglie a caso
+        constexpr Direction RANDOM_DIRECTIONS[] = {
+            D_UP, D_DOWN, D_LEFT, D_RIGHT, D_UPLEFT, D_UPRIGHT, D_DOWNLEFT, D_DOWNRIGHT
+        };
+    }
 
-        // Inizializza con direzione casuale
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<> dis(0, 7);
+    Zol::Zol(const Vec2<float> pos, const std::uint64_t seed, const std::string& configPath)
+        : Zol(pos, seed, CharacterConfig::load(configPath))
+    {
+    }
 
-        switch (dis(gen))
-        {
-            case 0: currentDirection_ = D_UP; break;
-            case 1: currentDirection_ = D_DOWN; break;
-            case 2: currentDirection_ = D_LEFT; break;
-            case 3: currentDirection_ = D_RIGHT; break;
-            case 4: currentDirection_ = D_UPLEFT; break;
-            case 5: currentDirection_ = D_UPRIGHT; break;
-            case 6: currentDirection_ = D_DOWNLEFT; break;
-            case 7: currentDirection_ = D_DOWNRIGHT; break;
-            default: currentDirection_ = D_DOWN; break;
-        }
+    Zol::Zol(const Vec2<float> pos, const std::uint64_t seed, std::shared_ptr<const CharacterConfig> config)
+        : Fighter(pos, std::move(config)), rng_(seed)
+    {
+        kind_ |= AK_ENEMY | AK_ZOL;
+
+        // Le clip sono compilate una volta sola nel CharacterConfig e condivise
+        movement_.setTable(&config_->animations);
+
+        // Inizializza con direzione casuale
+        currentDirection_ = RANDOM_DIRECTIONS[rng_.below(std::size(RANDOM_DIRECTIONS))];
 
         // Imposta stato iniziale
         movement_.set(S_MOVING, currentDirection_);
@@ -101,28 +48,8 @@ namespace lulu {
         // Cambia direzione ogni 30 frame circa
         if (directionCounter_ >= 30)
         {
-            // Genera una direzione casuale
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dis(0, 7);
-
-            const int randomDir = dis(gen);
-            Direction newDirection = currentDirection_;
-
-            switch (randomDir)
-            {
-            case 0: newDirection = D_UP; break;
-            case 1: newDirection = D_DOWN; break;
-            case 2: newDirection = D_LEFT; break;
-            case 3: newDirection = D_RIGHT; break;
-            case 4: newDirection = D_UPLEFT; break;
-            case 5: newDirection = D_UPRIGHT; break;
-            case 6: newDirection = D_DOWNLEFT; break;
-            case 7: newDirection = D_DOWNRIGHT; break;
-            default: newDirection = D_DOWN; break;
-            }
-
-            return newDirection;
+            // Genera una direzione casuale dallo stream dello Zol
+            return RANDOM_DIRECTIONS[rng_.below(std::size(RANDOM_DIRECTIONS))];
         }
 
         return currentDirection_;
@@ -131,21 +58,22 @@ namespace lulu {
     Vec2<float> Zol::calculateMovement(const Direction dir) const
     {
         Vec2<float> movement{};
-        const auto [x, y] = speed_.diagonal().value();
+        const Vec2<float> speed = this->speed();
+        const auto [x, y] = speed.diagonal().value();
 
         switch (dir)
         {
         case D_UP:
-            movement = {0, -speed_.y};
+            movement = {0, -speed.y};
             break;
         case D_DOWN:
-            movement = {0, speed_.y};
+            movement = {0, speed.y};
             break;
         case D_LEFT:
-            movement = {-speed_.x, 0};
+            movement = {-speed.x, 0};
             break;
         case D_RIGHT:
-            movement = {speed_.x, 0};
+            movement = {speed.x, 0};
             break;
         case D_UPLEFT:
             movement = {-x, -y};
@@ -204,7 +132,7 @@ namespace lulu {
             if (newDirection != D_NONE)
             {
                 // Applica il movimento
-                pos_ += calculateMovement(newDirection);
+                translate(calculateMovement(newDirection));
 
                 // Cambio direzione richiede reset animazione
                 if (movement_.currentDirection() != newDirection)
@@ -0,0 +1,110 @@
+#include "inputLog.hpp"
+#include "binaryIo.hpp"
+#include <stdexcept>
+
+namespace lulu
+{
+    namespace
+    {
+        // Formato (little-endian, vedi BinaryWriter):
+        //   "LLRP" u32 versione
+        //   u64 seme, f32 spawn.x, f32 spawn.y
+        //   u32 lunghezza + byte del percorso della stanza
+        //   u32 numero di run, poi per ogni run: u32 KeyMask, u32 tick
+        //   u64 numero di tick
+        //   u32 numero di hash (uguale al numero di tick), poi un u32 per tick
+        constexpr char MAGIC[4] = {'L', 'L', 'R', 'P'};
+        constexpr std::uint32_t VERSION = 3;
+    }
+
+    std::uint32_t InputLog::fold(const std::uint64_t hash)
+    {
+        return static_cast<std::uint32_t>(hash ^ hash >> 32);
+    }
+
+    InputLog::InputLog(std::string room, const std::uint64_t seed, const Vec2<float> spawn)
+        : room_(std::move(room)), seed_(seed), spawn_(spawn)
+    {
+    }
+
+    void InputLog::record(const KeyMask keys, const std::uint64_t hash)
+    {
+        // Stessi tasti del tick precedente: allunga il run corrente
+        if (!runs_.empty() && runs_.back().keys == keys)
+            ++runs_.back().ticks;
+        else
+            runs_.push_back({keys, 1});
+
+        hashes_.push_back(fold(hash));
+        ++ticks_;
+    }
+
+    const std::string& InputLog::room() const { return room_; }
+    std::uint64_t InputLog::seed() const { return seed_; }
+    const Vec2<float>& InputLog::spawn() const { return spawn_; }
+    const std::vector<InputLog::Run>& InputLog::runs() const { return runs_; }
+    std::size_t InputLog::tickCount() const { return static_cast<std::size_t>(ticks_); }
+
+    bool InputLog::matches(const std::size_t tick, const std::uint64_t hash) const
+    {
+        return tick < hashes_.size() && fold(hash) == hashes_[tick];
+    }
+
+    void InputLog::save(const std::string& path) const
+    {
+        BinaryWriter out;
+        out.putRaw(MAGIC);
+        out.put(VERSION);
+        out.put(seed_);
+        out.put(spawn_.x);
+        out.put(spawn_.y);
+        out.put(room_);
+
+        out.put(static_cast<std::uint32_t>(runs_.size()));
+        for (const auto& [keys, ticks] : runs_)
+        {
+            out.put(keys);
+            out.put(ticks);
+        }
+
+        out.put(ticks_);
+        out.put(static_cast<std::uint32_t>(hashes_.size()));
+        for (const std::uint32_t hash : hashes_)
+            out.put(hash);
+
+        out.save(path);
+    }
+
+    InputLog InputLog::load(const std::string& path)
+    {
+        BinaryReader in(path);
+        in.expectHeader(MAGIC, VERSION);
+
+        InputLog log;
+        log.seed_ = in.get<std::uint64_t>();
+        log.spawn_.x = in.get<float>();
+        log.spawn_.y = in.get<float>();
+        log.room_ = in.getString();
+
+        std::uint64_t runTicks = 0;
+        log.runs_.resize(in.getCount(2 * sizeof(std::uint32_t)));
+        for (auto& [keys, ticks] : log.runs_)
+        {
+            keys = in.get<KeyMask>();
+            ticks = in.get<std::uint32_t>();
+            runTicks += ticks;
+        }
+
+        log.ticks_ = in.get<std::uint64_t>();
+        log.hashes_.resize(in.getCount(sizeof(std::uint32_t)));
+        for (auto& hash : log.hashes_)
+            hash = in.get<std::uint32_t>();
+        in.expectEnd();
+
+        if (log.ticks_ != runTicks || log.hashes_.size() != log.ticks_)
+        {
+            throw std::runtime_error("Inconsistent input log: " + path);
+        }
+        return log;
+    }
+} // namespace lulu
@@ -0,0 +1,56 @@
+#include "radixSort.hpp"
+#include <array>
+
+namespace lulu
+{
+    void radixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+    {
+        constexpr std::size_t DIGITS = 4;
+        constexpr std::size_t BUCKETS = 256;
+        constexpr std::size_t INSERTION_LIMIT = 64;
+
+        const std::size_t count = items.size();
+
+        // Pochi elementi: azzerare e scorrere gli istogrammi costa più dell'insertion sort
+        if (count <= INSERTION_LIMIT)
+        {
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                const SortItem item = items[i];
+                std::size_t j = i;
+                for (; j > 0 && items[j - 1].key > item.key; --j)
+                    items[j] = items[j - 1];
+                items[j] = item;
+            }
+            return;
+        }
+
+        std::array<std::array<std::uint32_t, BUCKETS>, DIGITS> histograms{};
+        for (const SortItem& item : items)
+        {
+            for (std::size_t d = 0; d < DIGITS; ++d)
+                ++histograms[d][item.key >> (8 * d) & 0xff];
+        }
+
+        scratch.resize(count);
+        for (std::size_t d = 0; d < DIGITS; ++d)
+        {
+            auto& histogram = histograms[d];
+
+            // Tutti nello stesso bucket: la passata non cambierebbe nulla
+            if (histogram[items.front().key >> (8 * d) & 0xff] == count) continue;
+
+            std::uint32_t offset = 0;
+            for (std::uint32_t& bucket : histogram)
+            {
+                const std::uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (const SortItem& item : items)
+                scratch[histogram[item.key >> (8 * d) & 0xff]++] = item;
+            items.swap(scratch);
+        }
+    }
+} // namespace lulu
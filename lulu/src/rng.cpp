@@ -0,0 +1,47 @@
+#include "rng.hpp"
+#include <bit>
+
+namespace lulu
+{
+    Rng::Rng(std::uint64_t seed)
+    {
+        // splitmix64: espande il seme in 128 bit di stato mai tutti nulli
+        for (int i = 0; i < 4; i += 2)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= z >> 31;
+            state_[i] = static_cast<std::uint32_t>(z);
+            state_[i + 1] = static_cast<std::uint32_t>(z >> 32);
+        }
+    }
+
+    std::uint32_t Rng::next()
+    {
+        const std::uint32_t result = std::rotl(state_[1] * 5, 7) * 9;
+        const std::uint32_t t = state_[1] << 9;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 11);
+
+        return result;
+    }
+
+    std::uint64_t Rng::next64()
+    {
+        const std::uint64_t high = next();
+        return high << 32 | next();
+    }
+
+    std::uint32_t Rng::below(const std::uint32_t bound)
+    {
+        // Moltiplicazione al posto del modulo (Lemire): nessuna divisione
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(next()) * bound >> 32);
+    }
+} // namespace lulu
@@ -0,0 +1,373 @@
+#include "roomData.hpp"
+#include "binaryIo.hpp"
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace lulu
+{
+    namespace
+    {
+        // Formato (little-endian, vedi BinaryWriter):
+        //   "LLRM" u32 versione
+        //   stringhe sfondo e musica, u32 numero di tasti + tasti
+        //   pos, size (f32), u32 ha-seme + u64 seme
+        //   poi blocchi, nemici, porte e NPC: u32 numero + record
+        //   infine i tile: tileset, lati (f32), origine, colonne e righe (u32),
+        //   u32 numero di tipi + (flag, ha-source, source), celle (u16)
+        constexpr char MAGIC[4] = {'L', 'L', 'R', 'M'};
+        constexpr std::uint32_t VERSION = 2;
+
+        // Byte minimi occupati nel file, per controllare i conteggi prima di allocare (getCount)
+        constexpr std::size_t STRING_BYTES = sizeof(std::uint32_t); // Stringa vuota: solo la lunghezza
+        constexpr std::size_t BOOL_BYTES = sizeof(std::uint32_t);
+        constexpr std::size_t VEC2_BYTES = 2 * sizeof(float);
+        constexpr std::size_t CELL_BYTES = sizeof(std::uint16_t);
+
+        // Carattere delle celle vuote nelle righe del JSON (oltre allo spazio)
+        constexpr char EMPTY_CELL = '.';
+
+        std::atomic<std::size_t> loads{0};
+
+        Vec2<float> parseVec2(const nlohmann::json& j)
+        {
+            return Vec2{
+                j.at("x").get<float>(),
+                j.at("y").get<float>()
+            };
+        }
+
+        Vec2<float> parseSize(const nlohmann::json& j)
+        {
+            return Vec2{
+                j.at("width").get<float>(),
+                j.at("height").get<float>()
+            };
+        }
+
+        void putVec2(BinaryWriter& out, const Vec2<float> value)
+        {
+            out.put(value.x);
+            out.put(value.y);
+        }
+
+        Vec2<float> getVec2(BinaryReader& in)
+        {
+            const float x = in.get<float>();
+            return {x, in.get<float>()};
+        }
+
+        // Colonne o righe della griglia di tile: ognuna ha almeno una cella nel file
+        int getTileCount(BinaryReader& in)
+        {
+            const std::size_t count = in.getCount(CELL_BYTES);
+            if (count > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            {
+                throw std::runtime_error("Tile map too large");
+            }
+            return static_cast<int>(count);
+        }
+
+        /**
+         * Sezione "tiles": i tipi sono indicati da un carattere, le righe sono
+         * stringhe con un carattere per cella ('.' o ' ' = vuota)
+         */
+        TileMap parseTiles(const nlohmann::json& j, const Vec2<float> arenaPos)
+        {
+            TileMap tiles;
+            tiles.tileset = j.value("tileset", std::string{});
+            tiles.sourceSize = j.value("sourceSize", tiles.sourceSize);
+            tiles.tileSize = j.value("tileSize", tiles.tileSize);
+            tiles.origin = j.contains("pos") ? parseVec2(j.at("pos")) : arenaPos;
+
+            std::array<std::uint16_t, 256> typeOf;
+            typeOf.fill(TileMap::EMPTY);
+            for (const auto& [key, typeJson] : j.at("types").items())
+            {
+                if (key.size() != 1 || key[0] == EMPTY_CELL || key[0] == ' ')
+                {
+                    throw std::runtime_error("Invalid tile type key: \"" + key + "\"");
+                }
+
+                TileMap::Tile tile;
+                if (typeJson.value("solid", false))
+                    tile.flags |= TF_SOLID;
+                if (typeJson.contains("source"))
+                    tile.source = parseVec2(typeJson.at("source"));
+
+                typeOf[static_cast<unsigned char>(key[0])] = static_cast<std::uint16_t>(tiles.tiles.size());
+                tiles.tiles.push_back(tile);
+            }
+
+            const auto& rowsJson = j.at("rows");
+            tiles.rows = static_cast<int>(rowsJson.size());
+            for (const auto& rowJson : rowsJson)
+            {
+                const auto row = rowJson.get<std::string>();
+                if (tiles.columns == 0)
+                    tiles.columns = static_cast<int>(row.size());
+                if (static_cast<int>(row.size()) != tiles.columns)
+                {
+                    throw std::runtime_error("Tile rows of different lengths");
+                }
+
+                for (const char c : row)
+                {
+                    const std::uint16_t type = typeOf[static_cast<unsigned char>(c)];
+                    if (type == TileMap::EMPTY && c != EMPTY_CELL && c != ' ')
+                    {
+                        throw std::runtime_error(std::string("Unknown tile type: '") + c + "'");
+                    }
+                    tiles.cells.push_back(type);
+                }
+            }
+            return tiles;
+        }
+    }
+
+    RoomData RoomData::load(const std::string& path)
+    {
+        if (const auto compiled = freshCompiled(path, COMPILED_EXTENSION))
+            return readBinary(*compiled);
+        return parseJson(path);
+    }
+
+    std::size_t RoomData::loadCount()
+    {
+        return loads.load(std::memory_order_relaxed);
+    }
+
+    RoomData RoomData::parseJson(const std::string& path)
+    {
+        loads.fetch_add(1, std::memory_order_relaxed);
+
+        std::ifstream f(path);
+        if (!f.is_open())
+        {
+            throw std::runtime_error("Could not open config file: " + path);
+        }
+
+        nlohmann::json j;
+        f >> j;
+
+        RoomData room;
+        room.scene.background = j.at("background").get<std::string>();
+        room.scene.music = j.at("music").get<std::string>();
+        for (const auto& val : j.at("inputs"))
+            room.scene.inputs.push_back(static_cast<Key>(val.get<int>()));
+
+        const auto& arenaJson = j.at("arena");
+        room.pos = parseVec2(arenaJson.at("pos"));
+        room.size = parseSize(arenaJson.at("size"));
+        if (arenaJson.contains("seed"))
+            room.seed = arenaJson.at("seed").get<std::uint64_t>();
+
+        if (arenaJson.contains("actors"))
+        {
+            for (const auto& actorJson : arenaJson.at("actors"))
+                room.blocks.push_back({parseVec2(actorJson.at("pos")), parseSize(actorJson.at("size"))});
+        }
+
+        if (arenaJson.contains("enemies"))
+        {
+            for (const auto& enemyJson : arenaJson.at("enemies"))
+                room.enemies.push_back({enemyJson.at("type").get<std::string>(), parseVec2(enemyJson.at("pos"))});
+        }
+
+        if (arenaJson.contains("doors"))
+        {
+            for (const auto& doorJson : arenaJson.at("doors"))
+            {
+                room.doors.push_back({
+                    parseVec2(doorJson.at("pos")),
+                    parseSize(doorJson.at("size")),
+                    parseVec2(doorJson.at("spawn")),
+                    doorJson.at("destination").get<std::string>(),
+                    doorJson.at("changeMusic").get<bool>()
+                });
+            }
+        }
+
+        if (arenaJson.contains("NPCs"))
+        {
+            for (const auto& npcJson : arenaJson.at("NPCs"))
+            {
+                room.npcs.push_back({
+                    parseVec2(npcJson.at("pos")),
+                    parseSize(npcJson.at("size")),
+                    npcJson.at("name").get<std::string>(),
+                    npcJson.at("sprite").get<std::string>(),
+                    npcJson.at("dialoguePath").get<std::string>()
+                });
+            }
+        }
+
+        if (arenaJson.contains("tiles"))
+        {
+            room.tiles = parseTiles(arenaJson.at("tiles"), room.pos);
+            room.tiles.validate();
+        }
+
+        return room;
+    }
+
+    RoomData RoomData::readBinary(const std::string& path)
+    {
+        loads.fetch_add(1, std::memory_order_relaxed);
+
+        BinaryReader in(path);
+        in.expectHeader(MAGIC, VERSION);
+
+        RoomData room;
+        room.scene.background = in.getString();
+        room.scene.music = in.getString();
+        room.scene.inputs.resize(in.getCount(sizeof(std::uint32_t)));
+        for (Key& key : room.scene.inputs)
+            key = in.get<Key>();
+
+        room.pos = getVec2(in);
+        room.size = getVec2(in);
+        if (in.get<bool>())
+            room.seed = in.get<std::uint64_t>();
+        else
+            in.get<std::uint64_t>();
+
+        room.blocks.resize(in.getCount(2 * VEC2_BYTES));
+        for (auto& [pos, size] : room.blocks)
+        {
+            pos = getVec2(in);
+            size = getVec2(in);
+        }
+
+        room.enemies.resize(in.getCount(STRING_BYTES + VEC2_BYTES));
+        for (auto& [type, pos] : room.enemies)
+        {
+            type = in.getString();
+            pos = getVec2(in);
+        }
+
+        room.doors.resize(in.getCount(3 * VEC2_BYTES + STRING_BYTES + BOOL_BYTES));
+        for (auto& door : room.doors)
+        {
+            door.pos = getVec2(in);
+            door.size = getVec2(in);
+            door.spawn = getVec2(in);
+            door.destination = in.getString();
+            door.changeMusic = in.get<bool>();
+        }
+
+        room.npcs.resize(in.getCount(2 * VEC2_BYTES + 3 * STRING_BYTES));
+        for (auto& npc : room.npcs)
+        {
+            npc.pos = getVec2(in);
+            npc.size = getVec2(in);
+            npc.name = in.getString();
+            npc.sprite = in.getString();
+            npc.dialogue = in.getString();
+        }
+
+        auto& tiles = room.tiles;
+        tiles.tileset = in.getString();
+        tiles.sourceSize = in.get<float>();
+        tiles.tileSize = in.get<float>();
+        tiles.origin = getVec2(in);
+        tiles.columns = getTileCount(in);
+        tiles.rows = getTileCount(in);
+        tiles.tiles.resize(in.getCount(sizeof(std::uint8_t) + BOOL_BYTES + VEC2_BYTES));
+        for (auto& [flags, source] : tiles.tiles)
+        {
+            flags = in.get<std::uint8_t>();
+            const bool hasSource = in.get<bool>();
+            const Vec2<float> corner = getVec2(in);
+            if (hasSource)
+                source = corner;
+        }
+
+        // Anche il prodotto deve stare nei byte rimasti, non solo colonne e righe prese da sole
+        const auto columns = static_cast<std::size_t>(tiles.columns);
+        const auto rows = static_cast<std::size_t>(tiles.rows);
+        if (rows != 0 && columns > in.remaining() / CELL_BYTES / rows)
+        {
+            throw std::runtime_error("Truncated file: " + path);
+        }
+        tiles.cells.resize(columns * rows);
+        for (std::uint16_t& cell : tiles.cells)
+            cell = in.get<std::uint16_t>();
+
+        in.expectEnd();
+        tiles.validate();
+        return room;
+    }
+
+    void RoomData::writeBinary(const std::string& path) const
+    {
+        BinaryWriter out;
+        out.putRaw(MAGIC);
+        out.put(VERSION);
+
+        out.put(scene.background);
+        out.put(scene.music);
+        out.put(static_cast<std::uint32_t>(scene.inputs.size()));
+        for (const Key key : scene.inputs)
+            out.put(key);
+
+        putVec2(out, pos);
+        putVec2(out, size);
+        out.put(seed.has_value());
+        out.put(seed.value_or(0));
+
+        out.put(static_cast<std::uint32_t>(blocks.size()));
+        for (const auto& [blockPos, blockSize] : blocks)
+        {
+            putVec2(out, blockPos);
+            putVec2(out, blockSize);
+        }
+
+        out.put(static_cast<std::uint32_t>(enemies.size()));
+        for (const auto& [type, enemyPos] : enemies)
+        {
+            out.put(type);
+            putVec2(out, enemyPos);
+        }
+
+        out.put(static_cast<std::uint32_t>(doors.size()));
+        for (const auto& door : doors)
+        {
+            putVec2(out, door.pos);
+            putVec2(out, door.size);
+            putVec2(out, door.spawn);
+            out.put(door.destination);
+            out.put(door.changeMusic);
+        }
+
+        out.put(static_cast<std::uint32_t>(npcs.size()));
+        for (const auto& npc : npcs)
+        {
+            putVec2(out, npc.pos);
+            putVec2(out, npc.size);
+            out.put(npc.name);
+            out.put(npc.sprite);
+            out.put(npc.dialogue);
+        }
+
+        out.put(tiles.tileset);
+        out.put(tiles.sourceSize);
+        out.put(tiles.tileSize);
+        putVec2(out, tiles.origin);
+        out.put(static_cast<std::uint32_t>(tiles.columns));
+        out.put(static_cast<std::uint32_t>(tiles.rows));
+        out.put(static_cast<std::uint32_t>(tiles.tiles.size()));
+        for (const auto& [flags, source] : tiles.tiles)
+        {
+            out.put(flags);
+            out.put(source.has_value());
+            putVec2(out, source.value_or(Vec2<float>{}));
+        }
+        for (const std::uint16_t cell : tiles.cells)
+            out.put(cell);
+
+        out.save(path);
+    }
+} // namespace lulu
@@ -0,0 +1,131 @@
+#include "spatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lulu
+{
+    SpatialGrid::SpatialGrid(const float cellSize) : cellSize_(cellSize)
+    {
+    }
+
+    SpatialGrid::CellRange SpatialGrid::rangeOf(const Vec2<float>& pos, const Vec2<float>& size) const
+    {
+        // Gli estremi sono inclusi: un rettangolo che tocca il bordo di una cella
+        // viene registrato anche lì, la narrowphase scarterà il semplice contatto
+        return CellRange{
+            static_cast<int>(std::floor(pos.x / cellSize_)),
+            static_cast<int>(std::floor(pos.y / cellSize_)),
+            static_cast<int>(std::floor((pos.x + size.x) / cellSize_)),
+            static_cast<int>(std::floor((pos.y + size.y) / cellSize_))
+        };
+    }
+
+    std::int64_t SpatialGrid::cellKey(const int x, const int y)
+    {
+        return static_cast<std::int64_t>(x) << 32 | static_cast<std::uint32_t>(y);
+    }
+
+    void SpatialGrid::addToCells(const Entry& entry, const CellRange& range)
+    {
+        for (int cy = range.minY; cy <= range.maxY; ++cy)
+        {
+            for (int cx = range.minX; cx <= range.maxX; ++cx)
+            {
+                cells_[cellKey(cx, cy)].push_back(entry);
+            }
+        }
+    }
+
+    void SpatialGrid::removeFromCells(const ActorHandle handle, const CellRange& range)
+    {
+        for (int cy = range.minY; cy <= range.maxY; ++cy)
+        {
+            for (int cx = range.minX; cx <= range.maxX; ++cx)
+            {
+                const auto it = cells_.find(cellKey(cx, cy));
+                if (it == cells_.end()) continue;
+
+                auto& cell = it->second;
+                const auto entry = std::ranges::find(cell, handle, &Entry::handle);
+                if (entry != cell.end())
+                {
+                    // L'ordine dentro la cella non conta: swap-and-pop
+                    *entry = cell.back();
+                    cell.pop_back();
+                }
+
+                if (cell.empty())
+                    cells_.erase(it);
+            }
+        }
+    }
+
+    void SpatialGrid::insert(const ActorHandle handle, const std::uint64_t order, const Vec2<float> pos,
+                             const Vec2<float> size)
+    {
+        if (!handle.valid()) return;
+
+        remove(handle);
+        if (registrations_.size() <= handle.index)
+            registrations_.resize(handle.index + 1);
+
+        const Entry entry{handle, order};
+        const CellRange range = rangeOf(pos, size);
+        addToCells(entry, range);
+        registrations_[handle.index] = {range, entry, true};
+    }
+
+    void SpatialGrid::remove(const ActorHandle handle)
+    {
+        if (handle.index >= registrations_.size()) return;
+
+        Registration& registration = registrations_[handle.index];
+        if (!registration.active || registration.entry.handle != handle) return;
+
+        removeFromCells(handle, registration.range);
+        registration.active = false;
+    }
+
+    void SpatialGrid::update(const ActorHandle handle, const Vec2<float> pos, const Vec2<float> size)
+    {
+        if (handle.index >= registrations_.size()) return;
+
+        auto& [range, entry, active] = registrations_[handle.index];
+        if (!active || entry.handle != handle) return;
+
+        const CellRange newRange = rangeOf(pos, size);
+        if (newRange == range) return;
+
+        removeFromCells(handle, range);
+        addToCells(entry, newRange);
+        range = newRange;
+    }
+
+    void SpatialGrid::clear()
+    {
+        cells_.clear();
+        registrations_.clear();
+    }
+
+    void SpatialGrid::query(const Vec2<float>& pos, const Vec2<float>& size, std::vector<Entry>& out) const
+    {
+        out.clear();
+
+        const CellRange range = rangeOf(pos, size);
+        for (int cy = range.minY; cy <= range.maxY; ++cy)
+        {
+            for (int cx = range.minX; cx <= range.maxX; ++cx)
+            {
+                if (const auto it = cells_.find(cellKey(cx, cy)); it != cells_.end())
+                {
+                    out.insert(out.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+
+        // Un attore grande compare in più celle: ordina per spawn e rimuovi i duplicati
+        std::ranges::sort(out, {}, &Entry::order);
+        const auto [first, last] = std::ranges::unique(out, {}, &Entry::order);
+        out.erase(first, last);
+    }
+} // namespace lulu
@@ -0,0 +1,52 @@
+#include "spriteRegistry.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace lulu
+{
+    namespace
+    {
+        struct Registry
+        {
+            std::mutex mutex;
+            std::deque<std::string> paths{""}; // deque: i riferimenti restano validi dopo push_back
+            std::unordered_map<std::string, SpriteId> ids{{"", NO_SPRITE}};
+        };
+
+        Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+    }
+
+    SpriteId SpriteRegistry::intern(const std::string& path)
+    {
+        auto& [mutex, paths, ids] = registry();
+        std::scoped_lock lock(mutex);
+
+        const auto [it, inserted] = ids.try_emplace(path, static_cast<SpriteId>(paths.size()));
+        if (inserted)
+        {
+            paths.push_back(path);
+        }
+        return it->second;
+    }
+
+    const std::string& SpriteRegistry::path(const SpriteId id)
+    {
+        auto& [mutex, paths, ids] = registry();
+        std::scoped_lock lock(mutex);
+
+        return id < paths.size() ? paths[id] : paths.front();
+    }
+
+    std::size_t SpriteRegistry::size()
+    {
+        auto& [mutex, paths, ids] = registry();
+        std::scoped_lock lock(mutex);
+
+        return paths.size();
+    }
+} // namespace lulu
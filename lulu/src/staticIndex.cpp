@@ -0,0 +1,128 @@
+#include "staticIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lulu
+{
+    namespace
+    {
+        // Limite alle celle della griglia densa: stanze enormi e sparse usano celle più grandi
+        constexpr long long MAX_CELLS = 1 << 20;
+    }
+
+    StaticIndex::StaticIndex(const float cellSize) : minCellSize_(cellSize), cellSize_(cellSize)
+    {
+    }
+
+    void StaticIndex::build(std::vector<SpatialGrid::Entry> statics, const AabbBatch& boxes)
+    {
+        items_ = std::move(statics);
+        cellStart_.clear();
+        cellItems_.clear();
+        columns_ = rows_ = 0;
+
+        if (items_.empty()) return;
+
+        // Bounding box di tutti gli attori statici
+        Vec2<float> min{boxes.x()[0], boxes.y()[0]};
+        Vec2<float> max = min;
+        for (std::size_t i = 0; i < items_.size(); ++i)
+        {
+            min = {std::min(min.x, boxes.x()[i]), std::min(min.y, boxes.y()[i])};
+            max = {std::max(max.x, boxes.x()[i] + boxes.w()[i]), std::max(max.y, boxes.y()[i] + boxes.h()[i])};
+        }
+
+        // Una stanza piccola dopo una enorme torna alle celle fini
+        origin_ = min;
+        cellSize_ = minCellSize_;
+        const Vec2<float> extent = max - min;
+        while (true)
+        {
+            columns_ = static_cast<int>(std::floor(extent.x / cellSize_)) + 1;
+            rows_ = static_cast<int>(std::floor(extent.y / cellSize_)) + 1;
+            if (static_cast<long long>(columns_) * rows_ <= MAX_CELLS) break;
+            cellSize_ *= 2.0f;
+        }
+
+        const auto cellOf = [this](const float v, const float o, const int count)
+        {
+            return std::clamp(static_cast<int>(std::floor((v - o) / cellSize_)), 0, count - 1);
+        };
+
+        // Due passate: conteggio per cella, poi riempimento (layout CSR)
+        cellStart_.assign(static_cast<std::size_t>(columns_) * rows_ + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::vector<std::uint32_t> cursor;
+            if (pass == 1)
+            {
+                for (std::size_t c = 1; c < cellStart_.size(); ++c)
+                    cellStart_[c] += cellStart_[c - 1];
+                cellItems_.resize(cellStart_.back());
+                cursor.assign(cellStart_.begin(), cellStart_.end() - 1);
+            }
+
+            for (std::uint32_t i = 0; i < items_.size(); ++i)
+            {
+                const int minX = cellOf(boxes.x()[i], origin_.x, columns_);
+                const int maxX = cellOf(boxes.x()[i] + boxes.w()[i], origin_.x, columns_);
+                const int minY = cellOf(boxes.y()[i], origin_.y, rows_);
+                const int maxY = cellOf(boxes.y()[i] + boxes.h()[i], origin_.y, rows_);
+
+                for (int cy = minY; cy <= maxY; ++cy)
+                {
+                    for (int cx = minX; cx <= maxX; ++cx)
+                    {
+                        const std::size_t cell = static_cast<std::size_t>(cy) * columns_ + cx;
+                        if (pass == 0)
+                            ++cellStart_[cell + 1];
+                        else
+                            cellItems_[cursor[cell]++] = i;
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t StaticIndex::size() const
+    {
+        return items_.size();
+    }
+
+    void StaticIndex::query(const Vec2<float>& pos, const Vec2<float>& size,
+                            std::vector<SpatialGrid::Entry>& out) const
+    {
+        out.clear();
+        if (items_.empty()) return;
+
+        const Vec2<float> start = (pos - origin_) / cellSize_;
+        const Vec2<float> end = (pos + size - origin_) / cellSize_;
+
+        // Rettangolo completamente fuori dall'area coperta dagli statici
+        if (end.x < 0.0f || end.y < 0.0f || start.x >= static_cast<float>(columns_) ||
+            start.y >= static_cast<float>(rows_))
+            return;
+
+        const int minX = std::max(static_cast<int>(std::floor(start.x)), 0);
+        const int minY = std::max(static_cast<int>(std::floor(start.y)), 0);
+        const int maxX = std::min(static_cast<int>(std::floor(end.x)), columns_ - 1);
+        const int maxY = std::min(static_cast<int>(std::floor(end.y)), rows_ - 1);
+
+        scratch_.clear();
+        for (int cy = minY; cy <= maxY; ++cy)
+        {
+            const std::size_t row = static_cast<std::size_t>(cy) * columns_;
+            scratch_.insert(scratch_.end(), cellItems_.begin() + cellStart_[row + minX],
+                            cellItems_.begin() + cellStart_[row + maxX + 1]);
+        }
+
+        // items_ è ordinato per spawn: ordinare gli indici equivale a ordinare per spawn
+        std::ranges::sort(scratch_);
+        const auto [first, last] = std::ranges::unique(scratch_);
+        scratch_.erase(first, last);
+
+        out.reserve(scratch_.size());
+        for (const std::uint32_t i : scratch_)
+            out.push_back(items_[i]);
+    }
+} // namespace lulu
@@ -0,0 +1,111 @@
+#include "tileMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace lulu
+{
+    bool TileMap::empty() const
+    {
+        return cells.empty();
+    }
+
+    bool TileMap::visible() const
+    {
+        return std::ranges::any_of(tiles, [](const Tile& tile) { return tile.source.has_value(); });
+    }
+
+    void TileMap::validate() const
+    {
+        if (columns < 0 || rows < 0 || cells.size() != static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows))
+        {
+            throw std::runtime_error("Tile map cells do not match its size");
+        }
+        if (!empty() && (tileSize <= 0 || sourceSize <= 0))
+        {
+            throw std::runtime_error("Tile map with an invalid tile size");
+        }
+        if (std::ranges::any_of(cells, [this](const std::uint16_t cell) { return cell != EMPTY && cell >= tiles.size(); }))
+        {
+            throw std::runtime_error("Tile map cell with an unknown tile type");
+        }
+    }
+
+    const TileMap::Tile* TileMap::at(const int column, const int row) const
+    {
+        if (column < 0 || row < 0 || column >= columns || row >= rows) return nullptr;
+
+        const std::uint16_t cell = cells[static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) +
+                                         static_cast<std::size_t>(column)];
+        return cell == EMPTY ? nullptr : &tiles[cell];
+    }
+
+    void TileMap::set(const int column, const int row, const std::uint16_t type)
+    {
+        if (column < 0 || row < 0 || column >= columns || row >= rows)
+        {
+            throw std::out_of_range("Tile cell outside the map");
+        }
+        if (type != EMPTY && type >= tiles.size())
+        {
+            throw std::out_of_range("Unknown tile type");
+        }
+        cells[static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(column)] = type;
+    }
+
+    bool TileMap::solid(const int column, const int row) const
+    {
+        const Tile* tile = at(column, row);
+        return tile && tile->flags & TF_SOLID;
+    }
+
+    Vec2<float> TileMap::cellPos(const int column, const int row) const
+    {
+        return origin + Vec2{column, row}.convert<float>() * tileSize;
+    }
+
+    TileMap::Range TileMap::range(const Vec2<float>& pos, const Vec2<float>& size) const
+    {
+        const auto first = [this](const float coordinate) { return static_cast<int>(std::floor(coordinate / tileSize)); };
+        // Il bordo destro/inferiore è escluso: chi tocca appena una cella non la interseca.
+        // ceil - 1 invece di nextafter: si chiama per ogni Movable a ogni tick, e nextafter è una chiamata a libm
+        const auto last = [this](const float coordinate) { return static_cast<int>(std::ceil(coordinate / tileSize)) - 1; };
+        const Vec2<float> local = pos - origin;
+
+        return {
+            std::max(first(local.x), 0),
+            std::max(first(local.y), 0),
+            std::min(last(local.x + size.x), columns - 1),
+            std::min(last(local.y + size.y), rows - 1)
+        };
+    }
+
+    Direction TileMap::collision(const int column, const int row, const Vec2<float>& pos, const Vec2<float>& size) const
+    {
+        const auto [cx, cy] = cellPos(column, row);
+        const auto [x, y] = pos + size;
+        if (x <= cx || cx + tileSize <= pos.x || y <= cy || cy + tileSize <= pos.y)
+        {
+            return D_NONE;
+        }
+
+        // Lato della cella verso il centro del rettangolo, come in Actor::checkCollision
+        const Vec2<float> center = pos + size / 2.0f;
+        const float half = tileSize / 2.0f;
+
+        const bool fromLeft = center.x <= cx + half;
+        const Direction horizontal = fromLeft ? D_RIGHT : D_LEFT;
+        const float depthH = fromLeft ? x - cx : cx + tileSize - pos.x;
+        const bool openH = !solid(fromLeft ? column - 1 : column + 1, row);
+
+        const bool fromAbove = center.y <= cy + half;
+        const Direction vertical = fromAbove ? D_DOWN : D_UP;
+        const float depthV = fromAbove ? y - cy : cy + tileSize - pos.y;
+        const bool openV = !solid(column, fromAbove ? row - 1 : row + 1);
+
+        // Se entrambi i lati sono interni (cella circondata) decide solo la penetrazione
+        if (openH != openV)
+            return openH ? horizontal : vertical;
+        return depthH <= depthV ? horizontal : vertical;
+    }
+} // namespace lulu
@@ -0,0 +1,32 @@
+#include "transformStore.hpp"
+#include <algorithm>
+
+namespace lulu
+{
+    std::uint32_t TransformStore::push(const Vec2<float> pos, const Vec2<float> prevPos, const Vec2<float> size,
+                                       const Vec2<float> speed)
+    {
+        const auto index = static_cast<std::uint32_t>(x_.size());
+        x_.push_back(pos.x);
+        y_.push_back(pos.y);
+        prevX_.push_back(prevPos.x);
+        prevY_.push_back(prevPos.y);
+        w_.push_back(size.x);
+        h_.push_back(size.y);
+        speedX_.push_back(speed.x);
+        speedY_.push_back(speed.y);
+        return index;
+    }
+
+    void TransformStore::storePrevPositions()
+    {
+        std::ranges::copy(x_, prevX_.begin());
+        std::ranges::copy(y_, prevY_.begin());
+    }
+
+    Vec2<float> TransformStore::interpolatedPos(const std::uint32_t i, const float alpha) const
+    {
+        const Vec2<float> prev = prevPos(i);
+        return prev + (pos(i) - prev) * alpha;
+    }
+} // namespace lulu
@@ -8,6 +8,7 @@ namespace lulu
              const std::string& dialoguePath, const std::string& name)
         : Actor(pos, size, sprite), dialoguePath_(dialoguePath), name_(name)
     {
+        kind_ |= AK_NPC;
     }
 
     std::vector<DialogueLine> NPC::loadDialogue() const
@@ -0,0 +1,104 @@
+// Test: una volta caricata la stanza, gli attacchi di Link non toccano il disco.
+// Carica una stanza con Link, poi lo fa camminare e attaccare nelle quattro
+// direzioni attraverso Arena::tick, e fallisce se nel frattempo viene letto
+// un PNG (AnimationHandler::getSpriteDimension), un personaggio o una stanza.
+//
+// Va eseguito dalla radice del progetto (ctest lo fa da solo): legge assets/.
+
+#include "lulu.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Reads
+    {
+        std::size_t sprites, characters, rooms;
+
+        static Reads now()
+        {
+            return {lulu::AnimationHandler::readCount(), lulu::CharacterConfig::loadCount(), lulu::RoomData::loadCount()};
+        }
+    };
+
+    struct Step
+    {
+        const char* name;
+        lulu::KeyMask walk;
+    };
+
+    constexpr lulu::KeyMask SPACE = lulu::keyBit(lulu::K_SPACE);
+    const std::vector<Step> STEPS{
+        {"up", lulu::keyBit(lulu::K_W)},
+        {"right", lulu::keyBit(lulu::K_D)},
+        {"down", lulu::keyBit(lulu::K_S)},
+        {"left", lulu::keyBit(lulu::K_A)}
+    };
+
+    int failures = 0;
+
+    void check(const bool ok, const std::string& what)
+    {
+        if (!ok)
+        {
+            std::cerr << "FAIL: " << what << '\n';
+            ++failures;
+        }
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    const std::string room = argc > 1 ? argv[1] : "assets/dungeon/rooms/room 1.json"; // Ha degli zol
+
+    try
+    {
+        lulu::Arena arena(room, 42);
+        arena.spawn(std::make_unique<lulu::Link>(lulu::Vec2<float>{375, 400}));
+
+        const Reads before = Reads::now();
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (const auto& [name, walk] : STEPS)
+            {
+                for (int i = 0; i < 8; ++i)
+                    arena.tick(walk);
+
+                const lulu::Link* link = arena.first<lulu::Link>();
+                check(link != nullptr, "Link is still alive");
+                if (!link) break;
+
+                // Durante l'attacco i frame hanno dimensioni diverse da quelle di Link che cammina
+                const lulu::Vec2<float> walking = link->size();
+                bool attacked = false;
+                arena.tick(SPACE);
+                for (int i = 0; i < 30 && (link = arena.first<lulu::Link>()); ++i)
+                {
+                    attacked |= link->size().x != walking.x || link->size().y != walking.y;
+                    arena.tick(0);
+                }
+                check(attacked, std::string("Link attacked ") + name);
+            }
+        }
+
+        const Reads after = Reads::now();
+        check(after.sprites == before.sprites,
+              "sprite files opened during ticks: " + std::to_string(after.sprites - before.sprites));
+        check(after.characters == before.characters,
+              "character files read during ticks: " + std::to_string(after.characters - before.characters));
+        check(after.rooms == before.rooms,
+              "room files read during ticks: " + std::to_string(after.rooms - before.rooms));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (failures == 0)
+        std::cout << "attack io: ok\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,44 @@
+#pragma once
+// Ricerca degli asset JSON, condivisa dagli strumenti di build (lulu_compile, lulu_atlas)
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace tools
+{
+  enum AssetKind { A_ROOM, A_CHARACTER, A_OTHER };
+
+  // Il tipo di file si riconosce dalla sezione principale
+  inline AssetKind kindOf(const std::string& path)
+  {
+    std::ifstream f(path);
+    const nlohmann::json j = nlohmann::json::parse(f, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) return A_OTHER;
+    if (j.contains("arena")) return A_ROOM;
+    if (j.contains("actor")) return A_CHARACTER;
+    return A_OTHER;
+  }
+
+  // Tutti i JSON di stanze e personaggi, in ordine stabile (da lanciare dalla root del progetto)
+  inline std::vector<std::string> defaultAssets()
+  {
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> paths;
+    for (const auto* root : {"assets/dungeon/rooms", "assets/characters"})
+    {
+      if (!fs::exists(root)) continue;
+      for (const auto& entry : fs::recursive_directory_iterator(root))
+      {
+        if (entry.is_regular_file() && entry.path().extension() == ".json")
+          paths.push_back(entry.path().generic_string());
+      }
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+} // namespace tools
@@ -0,0 +1,68 @@
+// Compilatore degli asset: converte le stanze (assets/dungeon/rooms/*.json) e i
+// descrittori dei personaggi (assets/characters/*/*.json) nel formato binario
+// letto da RoomData::load e CharacterConfig::load (".lroom" e ".lchar").
+// I binari vengono scritti accanto ai JSON; il gioco li preferisce finché sono
+// più recenti del JSON corrispondente. Va lanciato dalla root del progetto.
+//
+// Uso: lulu_compile [FILE.json ...]   (senza argomenti: tutti gli asset)
+
+#include "assetFiles.hpp"
+#include "lulu.hpp"
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    // Compila un file e lo rilegge: un binario che non si rilegge non deve finire negli asset
+    std::string compile(const std::string& path, const tools::AssetKind kind)
+    {
+        if (kind == tools::A_ROOM)
+        {
+            const std::string out = lulu::compiledPath(path, lulu::RoomData::COMPILED_EXTENSION);
+            lulu::RoomData::parseJson(path).writeBinary(out);
+            lulu::RoomData::readBinary(out);
+            return out;
+        }
+
+        const std::string out = lulu::compiledPath(path, lulu::CharacterConfig::COMPILED_EXTENSION);
+        lulu::CharacterConfig::parseJson(path).writeBinary(out);
+        lulu::CharacterConfig::readBinary(out);
+        return out;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    std::vector<std::string> paths(argv + 1, argv + argc);
+    if (paths.empty())
+        paths = tools::defaultAssets();
+
+    int failures = 0;
+    for (const auto& path : paths)
+    {
+        const tools::AssetKind kind = tools::kindOf(path);
+        if (kind == tools::A_OTHER)
+        {
+            std::cout << "skip  " << path << '\n';
+            continue;
+        }
+
+        try
+        {
+            const std::string out = compile(path, kind);
+            std::cout << (kind == tools::A_ROOM ? "room  " : "char  ") << path << " -> " << out
+                      << " (" << fs::file_size(out) << " bytes)\n";
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "error " << path << ": " << e.what() << '\n';
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
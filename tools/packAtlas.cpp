@@ -0,0 +1,126 @@
+// Generatore dell'atlante delle sprite: raccoglie tutti i frame citati dai
+// personaggi (sprite iniziale e animazioni) e dalle stanze (sprite degli NPC),
+// li impacchetta con lulu::Atlas::pack e scrive le pagine PNG più la tabella
+// (".latlas") letta dal gioco. Gli sfondi restano fuori: sono già una texture
+// ciascuno e occuperebbero da soli una pagina. Va lanciato dalla root del progetto.
+//
+// Uso: lulu_atlas [--page-size N] [FILE.json ...]   (senza file: tutti gli asset)
+
+#include "assetFiles.hpp"
+#include "lulu.hpp"
+#include <raylib.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr const char* ATLAS_DIRECTORY = "assets/atlas";
+    constexpr const char* ATLAS_PATH = "assets/atlas/sprites.latlas";
+
+    // Tutte le sprite di un asset: per i personaggi ogni frame di ogni clip, per le stanze gli NPC
+    void collectSprites(const std::string& path, const tools::AssetKind kind, std::vector<std::string>& sprites)
+    {
+        if (kind == tools::A_ROOM)
+        {
+            for (const auto& npc : lulu::RoomData::parseJson(path).npcs)
+                sprites.push_back(npc.sprite);
+            return;
+        }
+
+        const auto config = lulu::CharacterConfig::parseJson(path);
+        sprites.push_back(lulu::SpriteRegistry::path(config.sprite));
+        for (std::size_t state = 0; state < lulu::STATE_COUNT; ++state)
+        {
+            for (std::size_t direction = 0; direction < lulu::DIRECTION_COUNT; ++direction)
+            {
+                const auto clip = config.animations.clip(static_cast<lulu::State>(state),
+                                                         static_cast<lulu::Direction>(direction));
+                for (const auto& frame : clip)
+                    sprites.push_back(lulu::SpriteRegistry::path(frame.sprite));
+            }
+        }
+    }
+
+    // Compone le pagine copiando ogni sprite nella sua regione
+    bool writePages(const lulu::Atlas& atlas)
+    {
+        std::vector<Image> pages;
+        for (const auto& page : atlas.pages())
+            pages.push_back(GenImageColor(static_cast<int>(page.size.x), static_cast<int>(page.size.y), BLANK));
+
+        for (const auto& [sprite, region] : atlas.entries())
+        {
+            Image image = LoadImage(sprite.c_str());
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            const Rectangle source{0, 0, region.size.x, region.size.y};
+            const Rectangle target{region.pos.x, region.pos.y, region.size.x, region.size.y};
+            ImageDraw(&pages[region.page], image, source, target, WHITE);
+            UnloadImage(image);
+        }
+
+        bool ok = true;
+        for (std::size_t i = 0; i < pages.size(); ++i)
+        {
+            ok = ExportImage(pages[i], atlas.pages()[i].image.c_str()) && ok;
+            UnloadImage(pages[i]);
+        }
+        return ok;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    int pageSize = 1024;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--page-size" && i + 1 < argc)
+            pageSize = std::stoi(argv[++i]);
+        else
+            paths.push_back(arg);
+    }
+    if (paths.empty())
+        paths = tools::defaultAssets();
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    try
+    {
+        std::vector<std::string> sprites;
+        for (const auto& path : paths)
+        {
+            if (const tools::AssetKind kind = tools::kindOf(path); kind != tools::A_OTHER)
+                collectSprites(path, kind, sprites);
+        }
+
+        fs::create_directories(ATLAS_DIRECTORY);
+        const auto atlas = lulu::Atlas::pack(sprites, std::string(ATLAS_DIRECTORY) + "/page ", pageSize);
+        if (!writePages(atlas))
+        {
+            std::cerr << "error: could not write the atlas pages\n";
+            return 1;
+        }
+        atlas.writeBinary(ATLAS_PATH);
+
+        for (const auto& sprite : sprites)
+        {
+            if (!atlas.region(lulu::SpriteRegistry::intern(sprite)))
+                std::cout << "skip  " << sprite << " (not a readable PNG)\n";
+        }
+        for (const auto& [image, size] : atlas.pages())
+            std::cout << "page  " << image << " (" << size.x << "x" << size.y << ")\n";
+        std::cout << "atlas " << ATLAS_PATH << " (" << atlas.entries().size() << " sprites)\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Divisore degli sfondi grandi: taglia un'immagine in chunk quadrati, scritti
+// in una cartella accanto all'immagine ("overworld.png" -> "overworld/3_1.png"),
+// più la tabella ".lchunks" letta da lulu::BackgroundChunks::find. Il gioco
+// terrà sulla GPU solo i chunk vicini alla camera invece dell'immagine intera.
+//
+// Uso: lulu_chunks [--chunk-size N] IMMAGINE.png ...
+
+#include "lulu.hpp"
+#include <raylib.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    void split(const std::string& path, const std::uint32_t chunkSize)
+    {
+        Image image = LoadImage(path.c_str());
+        if (!image.data)
+        {
+            throw std::runtime_error("Could not load image: " + path);
+        }
+
+        lulu::BackgroundChunks chunks;
+        chunks.size = lulu::Vec2{image.width, image.height}.convert<float>();
+        chunks.chunkSize = chunkSize;
+        chunks.directory = fs::path(path).replace_extension().generic_string();
+        fs::create_directories(chunks.directory);
+
+        bool ok = true;
+        for (int row = 0; row < chunks.rows(); ++row)
+        {
+            for (int column = 0; column < chunks.columns(); ++column)
+            {
+                const auto [x, y] = chunks.origin(column, row);
+                const Rectangle rect{x, y, std::min(static_cast<float>(chunkSize), chunks.size.x - x),
+                                     std::min(static_cast<float>(chunkSize), chunks.size.y - y)};
+                const Image chunk = ImageFromImage(image, rect);
+                ok = ExportImage(chunk, chunks.path(column, row).c_str()) && ok;
+                UnloadImage(chunk);
+            }
+        }
+        UnloadImage(image);
+
+        if (!ok)
+        {
+            throw std::runtime_error("Could not write the chunks of: " + path);
+        }
+
+        // La tabella per ultima: è lei a dire al gioco che i chunk sono pronti
+        const std::string table = lulu::compiledPath(path, lulu::BackgroundChunks::EXTENSION);
+        chunks.writeBinary(table);
+        std::cout << "split " << path << " -> " << chunks.directory << " (" << chunks.columns() << "x"
+                  << chunks.rows() << " chunks of " << chunkSize << " px), " << table << '\n';
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    std::uint32_t chunkSize = 256;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--chunk-size" && i + 1 < argc)
+            chunkSize = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else
+            paths.push_back(arg);
+    }
+
+    if (paths.empty() || chunkSize == 0)
+    {
+        std::cerr << "usage: lulu_chunks [--chunk-size N] IMAGE.png ...\n";
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int failures = 0;
+    for (const auto& path : paths)
+    {
+        try
+        {
+            split(path, chunkSize);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "error " << path << ": " << e.what() << '\n';
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}